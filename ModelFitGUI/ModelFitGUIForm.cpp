@@ -1,27 +1,27 @@
-/////////////////////////////////////////////////////////////////////
-//
-// The Main entry point for the ModelFitGUI Application
-//
-// Author: Jason Jenkins
-//
-/////////////////////////////////////////////////////////////////////
-
-#include "ModelFitGUIForm.h"
-
-/////////////////////////////////////////////////////////////////////
-
-using namespace System;
-using namespace System::Windows::Forms;
-
-/////////////////////////////////////////////////////////////////////
-
-[STAThreadAttribute]
-void Main(cli::array<String^>^ args) 
-{
-	Application::EnableVisualStyles();
-	Application::SetCompatibleTextRenderingDefault(false);
-	ModelFitGUI::ModelFitGUIForm form;
-	Application::Run(%form);
-}
-
-/////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////
+//
+// The Main entry point for the ModelFitGUI Application
+//
+// Author: Jason Jenkins
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "ModelFitGUIForm.h"
+
+/////////////////////////////////////////////////////////////////////
+
+using namespace System;
+using namespace System::Windows::Forms;
+
+/////////////////////////////////////////////////////////////////////
+
+[STAThreadAttribute]
+void Main(cli::array<String^>^ args) 
+{
+	Application::EnableVisualStyles();
+	Application::SetCompatibleTextRenderingDefault(false);
+	ModelFitGUI::ModelFitGUIForm form;
+	Application::Run(%form);
+}
+
+/////////////////////////////////////////////////////////////////////
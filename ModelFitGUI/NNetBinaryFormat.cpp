@@ -0,0 +1,457 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Implements the NNetBinaryFormat class
+//
+// Author: Jason Jenkins
+//
+// This class reads and writes the building blocks of the binary
+// neural network file format and checks the layout of binary files.
+//
+// The binary form of a neural network (see NeuralNet::writeToBinaryFile)
+// is much smaller and faster to read and write than the text form as
+// the weighted connections of each layer are stored as a raw block of
+// little-endian values. A file holds:
+//
+//   a 48 byte header - the "NNETBIN" tag, the format version, the
+//   scalar type of the header values, the numbers of inputs, outputs
+//   and hidden layers and the output unit type, slope and amplify 
+//   values
+//
+//   a 40 byte record for each layer (the hidden layers followed by
+//   the output layer) - the numbers of input and output nodes, the
+//   unit type, whether the layer was pruned, the type the weights are
+//   stored as and the slope and amplify values, followed by the 
+//   layer's weights row by row (with pruned connections written as 
+//   zeros) and, for a pruned layer, its connection mask - one bit for
+//   each connection row by row (the lowest bit of each byte first), 
+//   set if the connection remains
+//
+//   a Fletcher-64 checksum of everything before it
+//
+// Version 2 of the format allows a layer's weights to be stored as 16
+// bit fp16 or bf16 values (see NNetHalf) rather than doubles. Version
+// 3 adds the connection masks, as a remaining weight may be exactly 
+// zero (or round to zero as a 16 bit value) - version 1 and 2 files 
+// only have the zeros to go on. Each file is written with the lowest
+// version that can hold it, so files without 16 bit weights or pruned
+// layers can still be read by older builds.
+//
+// Every block is padded to a multiple of 8 bytes so the weights are 8
+// byte aligned within the file. On a little-endian machine the weights
+// can therefore be used straight from a memory mapping of the file 
+// (see NNetFrozen::openMapped).
+//
+// The readLayout method checks the header and layer records of a file
+// without copying any weights and records where each layer's weights
+// are to be found:
+/*
+		NNetBinaryFormat format;
+
+		if(format.readLayout(data, length) == 0)
+		{
+			const double* firstLayer = (const double*)(data + format.getWeightOffset(0));
+		}
+*/
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetBinaryFormat.h"
+
+/////////////////////////////////////////////////////////////////////
+
+#include <fstream>
+#include <cstdio>
+#include <string.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+/////////////////////////////////////////////////////////////////////
+
+const char NNetBinaryFormat::kTag[8] = { 'N', 'N', 'E', 'T', 'B', 'I', 'N', '\0' };
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// default constructor
+/// </summary>
+/// 
+NNetBinaryFormat::NNetBinaryFormat()
+{
+	mNumInputs = 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// destructor
+/// </summary>
+/// 
+NNetBinaryFormat::~NNetBinaryFormat()
+{
+}
+
+/////////////////////////////////////////////////////////////////////
+// Public Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// reads and checks the header and layer records of a binary network -
+/// 
+/// The checksum, the format version and scalar type, the sizes of the
+/// layers and the activation function types are all checked, so once
+/// this method succeeds the weights of every layer are known to lie
+/// within the buffer. The checksum can be skipped to avoid reading the
+/// whole buffer.
+/// </summary>
+/// <param name="data">the binary network</param>
+/// <param name="length">the length of the binary network</param>
+/// <param name="verifyChecksum">true to check the data against its checksum</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NNetBinaryFormat::readLayout(const char* data, size_t length, bool verifyChecksum)
+{
+	size_t pos = sizeof(kTag);
+	unsigned int version = 0, scalarType = 0;
+	int details[4];
+	double outDetails[2];
+
+	mNumInputs = 0;
+	mLayerSizes.clear();
+	mLayerTypes.clear();
+	mLayerSlope.clear();
+	mLayerAmplify.clear();
+	mLayerPruned.clear();
+	mLayerScalars.clear();
+	mWeightOffsets.clear();
+	mMaskOffsets.clear();
+
+	if(!hasTag(data, length) || length < (size_t)(kHeaderSize + kChecksumSize))
+	{
+		return -1;
+	}
+
+	// the checksum is not part of the network data
+	length -= kChecksumSize;
+
+	if(verifyChecksum)
+	{
+		size_t checkPos = length;
+		unsigned long long checksum = 0;
+
+		getValues(data, length + kChecksumSize, checkPos, &checksum, 8, 1);
+
+		if(checksum != getChecksum(data, length))
+		{
+			return -1;
+		}
+	}
+
+	// the header
+	getValues(data, length, pos, &version, 4, 1);
+	getValues(data, length, pos, &scalarType, 4, 1);
+	getValues(data, length, pos, details, 4, 4);
+	getValues(data, length, pos, outDetails, 8, 2);
+
+	if(version < kFirstVersion || version > kVersion || scalarType != kScalarFloat64 ||
+	   details[0] <= 0 || details[1] <= 0 || details[2] < 1 ||
+	   details[3] < kThreshold || details[3] > kSoftPlus)
+	{
+		return -1;
+	}
+
+	int nPrevOut = details[0];
+
+	// the layer records
+	for(int i = 0; i <= details[2]; i++)		// use <= to include the output layer
+	{
+		int layerDetails[6];
+		double layerValues[2];
+
+		if(!getValues(data, length, pos, layerDetails, 4, 6) ||
+		   !getValues(data, length, pos, layerValues, 8, 2))
+		{
+			mLayerSizes.clear();
+			return -1;
+		}
+
+		int nIn = layerDetails[0];
+		int nOut = layerDetails[1];
+		int nScalar = layerDetails[4];
+
+		// each layer must follow on from the previous one and its
+		// weights must lie within the buffer (version 1 only has doubles)
+		if(nIn != nPrevOut || nOut <= 0 || (i == details[2] && nOut != details[1]) ||
+		   (i < details[2] && (layerDetails[2] < kThreshold || layerDetails[2] > kSoftPlus)) ||
+		   nScalar < kFloat64 || nScalar > kBFloat16 || (version == kFirstVersion && nScalar != kFloat64) ||
+		   (size_t)nIn * nOut > (length - pos) / NNetHalf::getScalarSize((ScalarT)nScalar) ||
+		   getWeightBlockSize((size_t)nIn * nOut, (ScalarT)nScalar) > length - pos)
+		{
+			mLayerSizes.clear();
+			return -1;
+		}
+
+		// the output layer details are held in the header
+		mLayerSizes.push_back(nOut);
+		mLayerTypes.push_back((ActiveT)(i < details[2] ? layerDetails[2] : details[3]));
+		mLayerSlope.push_back(i < details[2] ? layerValues[0] : outDetails[0]);
+		mLayerAmplify.push_back(i < details[2] ? layerValues[1] : outDetails[1]);
+		mLayerPruned.push_back(layerDetails[3] != 0);
+		mLayerScalars.push_back((ScalarT)nScalar);
+		mWeightOffsets.push_back(pos);
+
+		pos += getWeightBlockSize((size_t)nIn * nOut, (ScalarT)nScalar);
+
+		// the connection mask of a pruned layer
+		if(version >= kMaskVersion && layerDetails[3] != 0)
+		{
+			if(getMaskBlockSize((size_t)nIn * nOut) > length - pos)
+			{
+				mLayerSizes.clear();
+				return -1;
+			}
+
+			mMaskOffsets.push_back(pos);
+			pos += getMaskBlockSize((size_t)nIn * nOut);
+		}
+		else
+		{
+			mMaskOffsets.push_back(0);
+		}
+
+		nPrevOut = nOut;
+	}
+
+	if(pos != length)
+	{
+		mLayerSizes.clear();
+		return -1;
+	}
+
+	mNumInputs = details[0];
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// checks whether a buffer starts with the binary network tag
+/// </summary>
+/// <param name="data">the buffer</param>
+/// <param name="length">the length of the buffer</param>
+/// <returns>true if the buffer starts with the tag</returns>
+/// 
+bool NNetBinaryFormat::hasTag(const char* data, size_t length)
+{
+	return length >= sizeof(kTag) && memcmp(data, kTag, sizeof(kTag)) == 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// checks whether this machine stores values in little-endian order
+/// </summary>
+/// <returns>true if the machine is little-endian</returns>
+/// 
+bool NNetBinaryFormat::isLittleEndian()
+{
+	const unsigned int one = 1;
+
+	return *reinterpret_cast<const unsigned char*>(&one) == 1;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// appends values to a buffer in little-endian order - the values are
+/// copied as a single block on a little-endian machine
+/// </summary>
+/// <param name="data">the buffer</param>
+/// <param name="values">the values</param>
+/// <param name="size">the size of each value in bytes</param>
+/// <param name="count">the number of values</param>
+/// 
+void NNetBinaryFormat::putValues(vector<char>& data, const void* values, size_t size, size_t count)
+{
+	size_t pos = data.size();
+	const char* bytes = static_cast<const char*>(values);
+
+	if(count == 0)
+	{
+		return;
+	}
+
+	data.resize(pos + size * count);
+
+	if(isLittleEndian())
+	{
+		memcpy(&data[pos], bytes, size * count);
+	}
+	else
+	{
+		for(size_t i = 0; i < count; i++)
+		{
+			reverse_copy(bytes + i * size, bytes + (i + 1) * size, &data[pos + i * size]);
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// reads little-endian values from a buffer
+/// </summary>
+/// <param name="data">the buffer</param>
+/// <param name="length">the length of the buffer</param>
+/// <param name="pos">the read position - moved past the values</param>
+/// <param name="values">receives the values</param>
+/// <param name="size">the size of each value in bytes</param>
+/// <param name="count">the number of values</param>
+/// <returns>true if successful or false if the buffer is too short</returns>
+/// 
+bool NNetBinaryFormat::getValues(const char* data, size_t length, size_t& pos, void* values, size_t size, size_t count)
+{
+	char* bytes = static_cast<char*>(values);
+
+	if(pos > length || count > (length - pos) / size)
+	{
+		return false;
+	}
+
+	// an empty block may come with no buffer to copy into
+	if(count == 0)
+	{
+		return true;
+	}
+
+	if(isLittleEndian())
+	{
+		memcpy(bytes, data + pos, size * count);
+	}
+	else
+	{
+		for(size_t i = 0; i < count; i++)
+		{
+			reverse_copy(data + pos + i * size, data + pos + (i + 1) * size, bytes + i * size);
+		}
+	}
+
+	pos += size * count;
+
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// calculates the checksum of a buffer - a Fletcher-64 checksum over
+/// little-endian 32 bit words, with any final partial word padded with
+/// zeros - 
+/// 
+/// Both sums are kept modulo 2^32 - 1 and the result holds the second
+/// sum in its upper 32 bits and the first in its lower 32 bits. The 
+/// sums are accumulated in 64 bits and only reduced after each block
+/// of kChecksumBlock words, so it runs at close to memory speed.
+/// </summary>
+/// <param name="data">the buffer</param>
+/// <param name="length">the length of the buffer</param>
+/// <returns>the checksum</returns>
+/// 
+unsigned long long NNetBinaryFormat::getChecksum(const char* data, size_t length)
+{
+	const unsigned long long modulus = 0xffffffffull;
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+	unsigned long long sum1 = 0, sum2 = 0;
+	size_t i = 0;
+
+	while(i + 4 <= length)
+	{
+		size_t blockEnd = min(length & ~(size_t)3, i + 4 * kChecksumBlock);
+
+		for(; i < blockEnd; i += 4)
+		{
+			// assemble the little-endian word - a single load on most machines
+			unsigned int word = bytes[i] | (bytes[i + 1] << 8) | (bytes[i + 2] << 16) | 
+								((unsigned int)bytes[i + 3] << 24);
+
+			sum1 += word;
+			sum2 += sum1;
+		}
+
+		sum1 %= modulus;
+		sum2 %= modulus;
+	}
+
+	// the final partial word is padded with zeros
+	if(i < length)
+	{
+		unsigned int word = 0;
+
+		for(int k = 0; i < length; i++, k++)
+		{
+			word |= (unsigned int)bytes[i] << (8 * k);
+		}
+
+		sum1 = (sum1 + word) % modulus;
+		sum2 = (sum2 + sum1) % modulus;
+	}
+
+	return (sum2 << 32) | sum1;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// writes a buffer to a file - the buffer is written to a temporary
+/// file which then replaces the file in a single step, so a reader 
+/// never sees an incomplete file and the pages of a mapped file (see
+/// NNetMappedFile) are never changed under it
+/// </summary>
+/// <param name="fname">the file</param>
+/// <param name="data">the buffer</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NNetBinaryFormat::writeFile(const string& fname, const vector<char>& data)
+{
+	string tempName = fname + ".tmp";
+	bool written = false;
+
+	{
+		ofstream outFile(tempName, ios::binary);
+
+		if(outFile.good())
+		{
+			outFile.write(data.data(), data.size());
+			outFile.close();
+			written = !outFile.fail();
+		}
+	}
+
+	if(written && replaceFile(tempName, fname) == 0)
+	{
+		return 0;
+	}
+
+	remove(tempName.c_str());
+
+	return -1;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// replaces a file with another in a single step - readers holding 
+/// the old file open keep reading the old contents
+/// </summary>
+/// <param name="source">the file to rename</param>
+/// <param name="target">the file to replace</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NNetBinaryFormat::replaceFile(const string& source, const string& target)
+{
+#ifdef _WIN32
+	BOOL replaced = MoveFileExA(source.c_str(), target.c_str(),
+								MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+
+	return replaced ? 0 : -1;
+#else
+	return (rename(source.c_str(), target.c_str()) == 0) ? 0 : -1;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////
@@ -0,0 +1,212 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NNetBinaryFormat class
+//
+// Author: Jason Jenkins
+//
+// This class reads and writes the building blocks of the binary
+// neural network file format and checks the layout of binary files.
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stddef.h>
+
+/////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetUnit.h"
+#include "NNetHalf.h"
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class reads and writes the building blocks of the binary
+/// neural network file format and checks the layout of binary files.
+/// </summary>
+/// 
+class NNetBinaryFormat
+{
+public:
+	NNetBinaryFormat();
+	virtual ~NNetBinaryFormat();
+
+	// reads and checks the header and layer records of a binary network
+	int readLayout(const char* data, size_t length, bool verifyChecksum = true);
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of input units</returns>
+	int getNumInputs() const { return mNumInputs; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of hidden layers</returns>
+	int getNumLayers() const { return max((int)mLayerSizes.size() - 1, 0); }
+
+	/// <summary>
+	/// </summary>
+	/// <param name="layer">the specified layer (getNumLayers() is the output layer)</param>
+	/// <returns>the number of units in the layer</returns>
+	int getLayerSize(int layer) const { return mLayerSizes[layer]; }
+
+	/// <summary>
+	/// </summary>
+	/// <param name="layer">the specified layer (getNumLayers() is the output layer)</param>
+	/// <returns>the number of inputs to the layer</returns>
+	int getLayerInputs(int layer) const { return (layer == 0) ? mNumInputs : mLayerSizes[layer - 1]; }
+
+	/// <summary>
+	/// </summary>
+	/// <param name="layer">the specified layer (getNumLayers() is the output layer)</param>
+	/// <returns>the layer unit activation function type</returns>
+	ActiveT getLayerType(int layer) const { return mLayerTypes[layer]; }
+
+	/// <summary>
+	/// </summary>
+	/// <param name="layer">the specified layer (getNumLayers() is the output layer)</param>
+	/// <returns>the layer unit activation function slope value</returns>
+	double getLayerSlope(int layer) const { return mLayerSlope[layer]; }
+
+	/// <summary>
+	/// </summary>
+	/// <param name="layer">the specified layer (getNumLayers() is the output layer)</param>
+	/// <returns>the layer unit activation function amplify value</returns>
+	double getLayerAmplify(int layer) const { return mLayerAmplify[layer]; }
+
+	/// <summary>
+	/// </summary>
+	/// <param name="layer">the specified layer (getNumLayers() is the output layer)</param>
+	/// <returns>true if the connections into the layer had been pruned</returns>
+	bool isLayerPruned(int layer) const { return mLayerPruned[layer]; }
+
+	/// <summary>
+	/// </summary>
+	/// <param name="layer">the specified layer (getNumLayers() is the output layer)</param>
+	/// <returns>the type the layer's weights are stored as</returns>
+	ScalarT getLayerScalarType(int layer) const { return mLayerScalars[layer]; }
+
+	/// <summary>
+	/// </summary>
+	/// <param name="layer">the specified layer (getNumLayers() is the output layer)</param>
+	/// <returns>the position of the layer's weights in the file (a multiple of 8)</returns>
+	size_t getWeightOffset(int layer) const { return mWeightOffsets[layer]; }
+
+	/// <summary>
+	/// </summary>
+	/// <param name="layer">the specified layer (getNumLayers() is the output layer)</param>
+	/// <returns>the position of the layer's connection mask in the file (0 if it has none)</returns>
+	size_t getMaskOffset(int layer) const { return mMaskOffsets[layer]; }
+
+	// checks whether a buffer starts with the binary network tag
+	static bool hasTag(const char* data, size_t length);
+
+	// checks whether this machine stores values in little-endian order
+	static bool isLittleEndian();
+
+	// appends values to a buffer in little-endian order
+	static void putValues(vector<char>& data, const void* values, size_t size, size_t count);
+
+	// reads little-endian values from a buffer
+	static bool getValues(const char* data, size_t length, size_t& pos, void* values, size_t size, size_t count);
+
+	// calculates the checksum of a buffer
+	static unsigned long long getChecksum(const char* data, size_t length);
+
+	// writes a buffer to a file by way of a temporary file
+	static int writeFile(const string& fname, const vector<char>& data);
+
+	// replaces a file with another in a single step
+	static int replaceFile(const string& source, const string& target);
+
+	/// <summary>
+	/// </summary>
+	/// <param name="numWeights">the number of weights in a layer</param>
+	/// <param name="scalarType">the type the weights are stored as</param>
+	/// <returns>the size of the layer's weights in the file (padded to a multiple of 8 bytes)</returns>
+	static size_t getWeightBlockSize(size_t numWeights, ScalarT scalarType) 
+	{ 
+		return (numWeights * NNetHalf::getScalarSize(scalarType) + 7) & ~(size_t)7; 
+	}
+
+	/// <summary>
+	/// </summary>
+	/// <param name="numWeights">the number of weights in a layer</param>
+	/// <returns>the size of the layer's connection mask in the file (padded to a multiple of 8 bytes)</returns>
+	static size_t getMaskBlockSize(size_t numWeights) 
+	{ 
+		return ((numWeights + 7) / 8 + 7) & ~(size_t)7; 
+	}
+
+public:
+	/// <summary>the tag at the start of a binary network file</summary>
+	static const char kTag[8];
+
+	/// <summary>the current format version - adds the connection masks of pruned layers to version 2</summary>
+	static const unsigned int kVersion = 3;
+
+	/// <summary>the first format version - still written when every layer holds doubles and none is pruned</summary>
+	static const unsigned int kFirstVersion = 1;
+
+	/// <summary>the first format version that allows 16 bit weights</summary>
+	static const unsigned int kHalfVersion = 2;
+
+	/// <summary>the first format version that holds a connection mask for each pruned layer</summary>
+	static const unsigned int kMaskVersion = 3;
+
+	/// <summary>the scalar type code of 64 bit floating point weights</summary>
+	static const unsigned int kScalarFloat64 = 0;
+
+	/// <summary>the size of the file header in bytes</summary>
+	static const int kHeaderSize = 48;
+
+	/// <summary>the size of each layer record in bytes (excluding the weights)</summary>
+	static const int kLayerRecordSize = 40;
+
+	/// <summary>the size of the checksum at the end of the file in bytes</summary>
+	static const int kChecksumSize = 8;
+
+	/// <summary>
+	/// the number of words summed before the checksum sums are reduced - 
+	/// the second sum stays well within 64 bits over a block
+	/// </summary>
+	static const size_t kChecksumBlock = 16384;
+
+private:
+	/// <summary>the number of input units</summary>
+	int mNumInputs;
+
+	/// <summary>the number of units in each layer (the last is the output layer)</summary>
+	vector<int> mLayerSizes;
+
+	/// <summary>the activation function type of each layer</summary>
+	vector<ActiveT> mLayerTypes;
+
+	/// <summary>the activation function slope value of each layer</summary>
+	vector<double> mLayerSlope;
+
+	/// <summary>the activation function amplify value of each layer</summary>
+	vector<double> mLayerAmplify;
+
+	/// <summary>whether the connections into each layer had been pruned</summary>
+	vector<bool> mLayerPruned;
+
+	/// <summary>the type each layer's weights are stored as</summary>
+	vector<ScalarT> mLayerScalars;
+
+	/// <summary>the position of each layer's weights in the file</summary>
+	vector<size_t> mWeightOffsets;
+
+	/// <summary>the position of each layer's connection mask in the file (0 if it has none)</summary>
+	vector<size_t> mMaskOffsets;
+};
+
+/////////////////////////////////////////////////////////////////////
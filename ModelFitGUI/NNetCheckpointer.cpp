@@ -0,0 +1,474 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Implements the NNetCheckpointer class
+//
+// Author: Jason Jenkins
+//
+// This class periodically saves the state of a neural network to a
+// file while it is being trained so a long training run can be
+// recovered after a crash.
+//
+// The training loop calls update once per epoch and a checkpoint is
+// taken whenever the given number of epochs or seconds has passed
+// since the last one. Taking a checkpoint only copies the weights of
+// the network into a buffer - the network is written to the file by
+// a background thread so the training loop never waits for the disk.
+// If a new checkpoint is taken while the previous one is still being
+// written the newer weights simply replace any that are waiting.
+//
+// Each checkpoint is written in binary form (see NeuralNet::writeToBinaryFile)
+// to a temporary file which then replaces the checkpoint file in a
+// single step, so the checkpoint file always holds a complete network
+// however the process ends. It can be loaded like any other network:
+/*
+		NNetCheckpointer checkpointer;
+
+		checkpointer.setFileName("training.net");
+		checkpointer.setInterval(1000, 60.0);	// every 1000 epochs or 60 seconds
+
+		for(int i = 1; i <= numEpochs; i++)
+		{
+			trainer.trainNeuralNet(net);
+			checkpointer.update(net, i);
+		}
+
+		checkpointer.flush();
+
+		...
+
+		NeuralNet recovered("training.net");
+*/
+// The trainer can be checkpointed along with the network by passing
+// it to update as well. Its state (see NNetTrainer::writeStateToFile)
+// is written to a second file - the checkpoint file name followed by 
+// ".state" - so the training can later be resumed exactly where it 
+// stopped. Both files are written out in full before either of them
+// is replaced. The two files are replaced one after the other, so a
+// crash between the two can leave the state of one checkpoint beside
+// the network of the one before. The state records a checksum of the
+// network's weights and NNetTrainer::readStateFromFile refuses such a
+// pair - the network on its own can still be used to restart training:
+/*
+		NeuralNet net("training.net");
+
+		if(trainer.readStateFromFile("training.net.state", net) != 0)
+		{
+			// start a new run from the recovered network
+		}
+*/
+//
+// This file uses the standard thread library so it is compiled as
+// native code.
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetCheckpointer.h"
+#include "NNetBinaryFormat.h"
+
+/////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// the snapshot and writer thread state of a checkpointer - the
+/// members below the mutex are shared with the writer thread
+/// </summary>
+/// 
+struct NNetCheckpointState
+{
+	/// <summary>the number of epochs between checkpoints (0 for none)</summary>
+	int epochInterval = 0;
+
+	/// <summary>the number of seconds between checkpoints (0 for none)</summary>
+	double secondsInterval = 0.0;
+
+	/// <summary>the epoch of the most recent checkpoint taken</summary>
+	int lastEpoch = 0;
+
+	/// <summary>the time of the most recent checkpoint taken</summary>
+	chrono::steady_clock::time_point lastTime = chrono::steady_clock::now();
+
+	/// <summary>guards the members below</summary>
+	mutex lock;
+
+	/// <summary>signals the writer thread and any waiting flush</summary>
+	condition_variable signal;
+
+	/// <summary>the file the checkpoints are written to</summary>
+	string fileName;
+
+	/// <summary>a copy of the network whose weights are being checkpointed</summary>
+	NeuralNet pendingNet;
+
+	/// <summary>the weights of the checkpoint waiting to be written</summary>
+	vector<double> pendingWeights;
+
+	/// <summary>the trainer state of the checkpoint waiting to be written (empty if none)</summary>
+	vector<char> pendingTrainerState;
+
+	/// <summary>the epoch of the checkpoint waiting to be written</summary>
+	int pendingEpoch = 0;
+
+	/// <summary>true if a checkpoint is waiting to be written</summary>
+	bool hasPending = false;
+
+	/// <summary>true if the network has changed other than in its weights since the last checkpoint</summary>
+	bool netChanged = false;
+
+	/// <summary>true while the writer thread is writing a checkpoint</summary>
+	bool writing = false;
+
+	/// <summary>true when the writer thread is to finish</summary>
+	bool stopping = false;
+
+	/// <summary>the result of the most recent write</summary>
+	int lastResult = 0;
+
+	/// <summary>the epoch of the most recent checkpoint written to the file</summary>
+	int savedEpoch = 0;
+
+	/// <summary>the writer thread</summary>
+	thread writer;
+};
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// writes a buffer to a file
+/// </summary>
+/// <param name="fname">the file</param>
+/// <param name="data">the buffer</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+static int writeData(const string& fname, const vector<char>& data)
+{
+	ofstream outFile(fname, ios::binary);
+
+	if(outFile.good())
+	{
+		outFile.write(data.data(), data.size());
+	}
+
+	return outFile.good() ? 0 : -1;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// writes each checkpoint as it is taken until the checkpointer is
+/// destroyed - the file is written without holding the lock
+/// </summary>
+/// <param name="state">the checkpointer state</param>
+/// 
+static void writeCheckpoints(NNetCheckpointState* state)
+{
+	NeuralNet net;
+	vector<double> weights;
+	vector<char> trainerState;
+	unique_lock<mutex> guard(state->lock);
+
+	while(true)
+	{
+		state->signal.wait(guard, [state] { return state->hasPending || state->stopping; });
+
+		if(!state->hasPending)
+		{
+			break;
+		}
+
+		// take the waiting checkpoint - the training loop's buffer is
+		// swapped rather than copied
+		if(state->netChanged)
+		{
+			net = state->pendingNet;
+			state->netChanged = false;
+		}
+
+		weights.swap(state->pendingWeights);
+		trainerState.swap(state->pendingTrainerState);
+		state->pendingTrainerState.clear();
+
+		string fname = state->fileName;
+		int epoch = state->pendingEpoch;
+
+		state->hasPending = false;
+		state->writing = true;
+		guard.unlock();
+
+		// write to temporary files first so the checkpoint files are never incomplete
+		string tempName = fname + ".tmp";
+		string stateName = fname + ".state";
+		string tempStateName = stateName + ".tmp";
+		int result = -1;
+
+		if(net.setWeights(weights) == 0 && net.writeToBinaryFile(tempName) == 0)
+		{
+			if(trainerState.empty())
+			{
+				result = NNetBinaryFormat::replaceFile(tempName, fname);
+			}
+			else if(writeData(tempStateName, trainerState) == 0 && NNetBinaryFormat::replaceFile(tempStateName, stateName) == 0)
+			{
+				result = NNetBinaryFormat::replaceFile(tempName, fname);
+			}
+		}
+
+		guard.lock();
+		state->writing = false;
+		state->lastResult = result;
+
+		if(result == 0)
+		{
+			state->savedEpoch = epoch;
+		}
+
+		state->signal.notify_all();
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// default constructor - starts the writer thread
+/// </summary>
+/// 
+NNetCheckpointer::NNetCheckpointer()
+	: mState(new NNetCheckpointState())
+{
+	mState->fileName = "checkpoint.net";
+	mState->writer = thread(writeCheckpoints, mState.get());
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// destructor - any checkpoint waiting to be written is written
+/// before the writer thread finishes
+/// </summary>
+/// 
+NNetCheckpointer::~NNetCheckpointer()
+{
+	{
+		lock_guard<mutex> guard(mState->lock);
+		mState->stopping = true;
+	}
+
+	mState->signal.notify_all();
+	mState->writer.join();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Public Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets the file the checkpoints are written to
+/// </summary>
+/// <param name="fname">the checkpoint file</param>
+/// 
+void NNetCheckpointer::setFileName(const string& fname)
+{
+	lock_guard<mutex> guard(mState->lock);
+
+	mState->fileName = fname;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets how often a checkpoint is taken - a checkpoint is due when
+/// either interval has passed (an interval of 0 is not used)
+/// </summary>
+/// <param name="numEpochs">the number of epochs between checkpoints</param>
+/// <param name="numSeconds">the number of seconds between checkpoints</param>
+/// 
+void NNetCheckpointer::setInterval(int numEpochs, double numSeconds)
+{
+	mState->epochInterval = max(numEpochs, 0);
+	mState->secondsInterval = max(numSeconds, 0.0);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the file the training state is written to - the checkpoint 
+/// file name followed by ".state"
+/// </summary>
+/// <returns>the training state file</returns>
+/// 
+string NNetCheckpointer::getStateFileName() const
+{
+	lock_guard<mutex> guard(mState->lock);
+
+	return mState->fileName + ".state";
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// takes a checkpoint of the network if one is due - this is called
+/// by the training loop after each epoch
+/// </summary>
+/// <param name="nNet">the network being trained</param>
+/// <param name="epoch">the number of epochs completed</param>
+/// <returns>true if a checkpoint was taken</returns>
+/// 
+bool NNetCheckpointer::update(const NeuralNet& nNet, int epoch)
+{
+	bool due = isDue(epoch);
+
+	if(due)
+	{
+		takeCheckpoint(nNet, epoch);
+	}
+
+	return due;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// takes a checkpoint of the network and its trainer if one is due - 
+/// this is called by the training loop after each epoch
+/// </summary>
+/// <param name="nNet">the network being trained</param>
+/// <param name="trainer">the trainer training the network</param>
+/// <param name="epoch">the number of epochs completed</param>
+/// <returns>true if a checkpoint was taken</returns>
+/// 
+bool NNetCheckpointer::update(const NeuralNet& nNet, const NNetTrainer& trainer, int epoch)
+{
+	bool due = isDue(epoch);
+
+	if(due)
+	{
+		takeCheckpoint(nNet, trainer, epoch);
+	}
+
+	return due;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// takes a checkpoint of the network - only the weights are copied
+/// (unless anything else about the network has changed) and it is
+/// written to the file in the background
+/// </summary>
+/// <param name="nNet">the network being trained</param>
+/// <param name="epoch">the number of epochs completed</param>
+/// 
+void NNetCheckpointer::takeCheckpoint(const NeuralNet& nNet, int epoch)
+{
+	vector<char> trainerState;
+
+	queueCheckpoint(nNet, trainerState, epoch);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// takes a checkpoint of the network and its trainer - the trainer 
+/// state is written to the state file alongside the network
+/// </summary>
+/// <param name="nNet">the network being trained</param>
+/// <param name="trainer">the trainer training the network</param>
+/// <param name="epoch">the number of epochs completed</param>
+/// 
+void NNetCheckpointer::takeCheckpoint(const NeuralNet& nNet, const NNetTrainer& trainer, int epoch)
+{
+	vector<char> trainerState;
+
+	// the state is generated before the lock is taken
+	trainer.serializeState(trainerState, nNet);
+
+	queueCheckpoint(nNet, trainerState, epoch);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// waits until every checkpoint taken has been written
+/// </summary>
+/// <returns>0 if the most recent checkpoint was written otherwise -1</returns>
+/// 
+int NNetCheckpointer::flush()
+{
+	unique_lock<mutex> guard(mState->lock);
+
+	mState->signal.wait(guard, [this] { return !mState->hasPending && !mState->writing; });
+
+	return mState->lastResult;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the epoch of the most recent checkpoint written to the file
+/// </summary>
+/// <returns>the epoch of the most recent checkpoint or 0 if none has been written</returns>
+/// 
+int NNetCheckpointer::getSavedEpoch() const
+{
+	lock_guard<mutex> guard(mState->lock);
+
+	return mState->savedEpoch;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Private Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// checks whether a checkpoint is due
+/// </summary>
+/// <param name="epoch">the number of epochs completed</param>
+/// <returns>true if either interval has passed since the last checkpoint</returns>
+/// 
+bool NNetCheckpointer::isDue(int epoch) const
+{
+	bool due = (mState->epochInterval > 0 && epoch - mState->lastEpoch >= mState->epochInterval);
+
+	if(!due && mState->secondsInterval > 0)
+	{
+		chrono::duration<double> elapsed = chrono::steady_clock::now() - mState->lastTime;
+
+		due = (elapsed.count() >= mState->secondsInterval);
+	}
+
+	return due;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// passes a checkpoint to the writer thread - any checkpoint still 
+/// waiting to be written is replaced
+/// </summary>
+/// <param name="nNet">the network being trained</param>
+/// <param name="trainerState">the trainer state (empty if none) - swapped into the checkpoint</param>
+/// <param name="epoch">the number of epochs completed</param>
+/// 
+void NNetCheckpointer::queueCheckpoint(const NeuralNet& nNet, vector<char>& trainerState, int epoch)
+{
+	lock_guard<mutex> guard(mState->lock);
+
+	NeuralNet& pendingNet = mState->pendingNet;
+
+	// the network itself is only copied when anything other than its
+	// weights has changed
+	if(!pendingNet.hasSameTopology(nNet))
+	{
+		pendingNet = nNet;
+		mState->netChanged = true;
+	}
+
+	nNet.getWeights(mState->pendingWeights);
+	mState->pendingTrainerState.swap(trainerState);
+
+	mState->pendingEpoch = epoch;
+	mState->hasPending = true;
+	mState->lastEpoch = epoch;
+	mState->lastTime = chrono::steady_clock::now();
+
+	mState->signal.notify_all();
+}
+
+/////////////////////////////////////////////////////////////////////
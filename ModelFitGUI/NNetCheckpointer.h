@@ -0,0 +1,90 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NNetCheckpointer class
+//
+// Author: Jason Jenkins
+//
+// This class periodically saves the state of a neural network to a
+// file while it is being trained so a long training run can be
+// recovered after a crash.
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <memory>
+
+/////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////
+
+#include "NeuralNet.h"
+#include "NNetTrainer.h"
+
+/////////////////////////////////////////////////////////////////////
+
+// the snapshot and writer thread state (defined in NNetCheckpointer.cpp)
+struct NNetCheckpointState;
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class periodically saves the state of a neural network to a
+/// file while it is being trained so a long training run can be
+/// recovered after a crash.
+/// </summary>
+/// 
+class NNetCheckpointer
+{
+public:
+	NNetCheckpointer();
+	virtual ~NNetCheckpointer();
+
+	// sets the file the checkpoints are written to
+	void setFileName(const string& fname);
+
+	// sets how often a checkpoint is taken
+	void setInterval(int numEpochs, double numSeconds);
+
+	// gets the file the training state is written to
+	string getStateFileName() const;
+
+	// takes a checkpoint of the network if one is due
+	bool update(const NeuralNet& nNet, int epoch);
+
+	// takes a checkpoint of the network and its trainer if one is due
+	bool update(const NeuralNet& nNet, const NNetTrainer& trainer, int epoch);
+
+	// takes a checkpoint of the network
+	void takeCheckpoint(const NeuralNet& nNet, int epoch);
+
+	// takes a checkpoint of the network and its trainer
+	void takeCheckpoint(const NeuralNet& nNet, const NNetTrainer& trainer, int epoch);
+
+	// waits until every checkpoint taken has been written
+	int flush();
+
+	// gets the epoch of the most recent checkpoint written to the file
+	int getSavedEpoch() const;
+
+private:
+	// checks whether a checkpoint is due
+	bool isDue(int epoch) const;
+
+	// passes a checkpoint to the writer thread
+	void queueCheckpoint(const NeuralNet& nNet, vector<char>& trainerState, int epoch);
+
+	// a checkpointer can not be copied
+	NNetCheckpointer(const NNetCheckpointer&) = delete;
+	NNetCheckpointer& operator=(const NNetCheckpointer&) = delete;
+
+private:
+	/// <summary>the snapshot and writer thread state</summary>
+	unique_ptr<NNetCheckpointState> mState;
+};
+
+/////////////////////////////////////////////////////////////////////
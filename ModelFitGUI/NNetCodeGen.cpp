@@ -0,0 +1,447 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Implements the NNetCodeGen class
+//
+// Author: Jason Jenkins
+//
+// This class generates a self-contained C++ header file from a
+// trained neural network (NeuralNet).
+//
+// A network that is only ever used to calculate responses, on an
+// embedded device for example, does not need to be read from a file
+// at all. The generated header holds the weighted connections as
+// constexpr arrays and a predict function in which every unit input
+// is written out as a sum of weight * value terms followed by the
+// activation function of its layer, with the slope and amplify values
+// written in as constants (multiplications by 1 are left out). As
+// nothing is left to be decided at run time the compiler is free to
+// fold the constants and vectorise the whole calculation. Pruned
+// (zero) connections are left out of the sums.
+/*
+		NNetCodeGen codeGen;
+
+		codeGen.writeHeader(net, "WageModel", "WageModel.h");
+*/
+// The generated header only needs <cmath> and can be used as follows:
+/*
+		#include "WageModel.h"
+
+		double inputs[WageModel::kNumInputs] = { 0.035 };
+		double outputs[WageModel::kNumOutputs];
+
+		WageModel::predict(inputs, outputs);
+*/
+// The sums and activation functions are evaluated in the same order
+// as NeuralNet::getResponse and every constant is written with enough
+// digits to reproduce it exactly. A compiler allowed to contract a 
+// multiply and an add into a single fused multiply-add (FMA) rounds 
+// once where the network rounds twice, so the header turns contraction
+// off for the predict function (with #pragma fp_contract on MSVC, 
+// which can not be undone so it stays off for the rest of the file 
+// that includes the header, #pragma STDC FP_CONTRACT on clang and an
+// optimize pragma on gcc). The generated code then gives the same 
+// responses as the network it was generated from, as long as the 
+// network itself was not built to use FMA instructions (for example 
+// with /arch:AVX2 or -march=native) - otherwise they agree to within
+// rounding.
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetCodeGen.h"
+#include "NNetLocale.h"
+
+/////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include <stdio.h>
+#include <ctype.h>
+#include <sstream>
+#include <fstream>
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// default constructor
+/// </summary>
+/// 
+NNetCodeGen::NNetCodeGen()
+{
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// destructor
+/// </summary>
+/// 
+NNetCodeGen::~NNetCodeGen()
+{
+}
+
+/////////////////////////////////////////////////////////////////////
+// Public Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// generates the C++ source code of a header file for a network - the
+/// weights, the predict function and the constants describing the
+/// network are placed in a namespace with the given name
+/// </summary>
+/// <param name="net">the network</param>
+/// <param name="name">the namespace name (must be a valid C++ identifier)</param>
+/// <param name="source">receives the source code</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NNetCodeGen::generateHeader(const NeuralNet& net, const string& name, string& source) const
+{
+	int numHidden = net.getNumLayers();
+	ostringstream code;
+
+	if(!isIdentifier(name) || numHidden < 1)
+	{
+		return -1;
+	}
+
+	code << "//////////////////////////////////////////////////////////////////////" << endl;
+	code << "//" << endl;
+	code << "// Generated by NNetCodeGen from a trained neural network - do not edit" << endl;
+	code << "//" << endl;
+	code << "// " << name << "::predict(inputs, outputs) calculates the response of the" << endl;
+	code << "// network: inputs holds kNumInputs values and outputs receives kNumOutputs" << endl;
+	code << "// values." << endl;
+	code << "//" << endl;
+	code << "//////////////////////////////////////////////////////////////////////" << endl;
+	code << endl;
+	code << "#pragma once" << endl;
+	code << endl;
+	code << "#include <cmath>" << endl;
+	code << endl;
+	code << "// the sums are calculated as written - without fused multiply-adds" << endl;
+	code << "#if defined(_MSC_VER) && !defined(__clang__)" << endl;
+	code << "#pragma fp_contract(off)" << endl;
+	code << "#elif defined(__GNUC__) && !defined(__clang__)" << endl;
+	code << "#pragma GCC push_options" << endl;
+	code << "#pragma GCC optimize(\"fp-contract=off\")" << endl;
+	code << "#endif" << endl;
+	code << endl;
+	code << "namespace " << name << endl;
+	code << "{" << endl;
+	code << "\tconstexpr int kNumInputs = " << net.getNumInputs() << ";" << endl;
+	code << "\tconstexpr int kNumOutputs = " << net.getNumOutputs() << ";" << endl;
+
+	// the weighted connections - one row for each unit
+	for(int i = 0; i <= numHidden; i++)		// use <= to include the output layer
+	{
+		const NNetWeightedConnect& connect = net.getWeightedConnect(i);
+		vector<double> weights;
+
+		int nIn = connect.getNumInputNodes();
+		int nOut = connect.getNumOutputNodes();
+
+		code << endl;
+		code << "\tconstexpr double kWeights" << i << "[" << nOut << "][" << nIn << "] =" << endl;
+		code << "\t{" << endl;
+
+		for(int j = 0; j < nOut; j++)
+		{
+			connect.getWeightVector(j, weights);
+
+			code << "\t\t{ ";
+
+			for(int k = 0; k < nIn; k++)
+			{
+				if(!isfinite(weights[k]))
+				{
+					return -1;
+				}
+
+				code << toLiteral(weights[k]) << (k < nIn - 1 ? ", " : " ");
+			}
+
+			code << "}" << (j < nOut - 1 ? "," : "") << endl;
+		}
+
+		code << "\t};" << endl;
+	}
+
+	// the unrolled predict function
+	code << endl;
+	code << "\tinline void predict(const double* inputs, double* outputs)" << endl;
+	code << "\t{" << endl;
+	code << "#if defined(__clang__)" << endl;
+	code << "#pragma STDC FP_CONTRACT OFF" << endl;
+	code << "#endif" << endl;
+	code << endl;
+
+	for(int i = 0; i <= numHidden; i++)
+	{
+		const NNetWeightedConnect& connect = net.getWeightedConnect(i);
+		vector<double> weights;
+		ActiveT unitType = net.getOutputUnitType();
+		double slope = net.getOutputUnitSlope();
+		double amplify = net.getOutputUnitAmplify();
+
+		if(i < numHidden)
+		{
+			net.getLayerDetails(i, unitType, slope, amplify);
+		}
+
+		int nIn = connect.getNumInputNodes();
+		int nOut = connect.getNumOutputNodes();
+
+		if(i < numHidden)
+		{
+			code << "\t\t// hidden layer " << i + 1;
+		}
+		else
+		{
+			code << "\t\t// output layer";
+		}
+
+		code << " - " << NNetUnit::ActiveTtoString(unitType) << " units, slope "
+			 << toLiteral(slope) << ", amplify " << toLiteral(amplify) << endl;
+
+		for(int j = 0; j < nOut; j++)
+		{
+			ostringstream unitInput;
+			bool first = true;
+
+			connect.getWeightVector(j, weights);
+
+			unitInput << "u" << i + 1 << "_" << j;
+
+			code << "\t\tconst double " << unitInput.str() << " = ";
+
+			for(int k = 0; k < nIn; k++)
+			{
+				// pruned connections make no contribution
+				if(weights[k] != 0)
+				{
+					code << (first ? "" : " + ") << "kWeights" << i << "[" << j << "][" << k << "] * ";
+
+					if(i == 0)
+					{
+						code << "inputs[" << k << "]";
+					}
+					else
+					{
+						code << "h" << i << "_" << k;
+					}
+
+					first = false;
+				}
+			}
+
+			if(first)
+			{
+				code << "0.0";
+			}
+
+			code << ";" << endl;
+
+			if(i < numHidden)
+			{
+				code << "\t\tconst double h" << i + 1 << "_" << j << " = ";
+			}
+			else
+			{
+				code << "\t\toutputs[" << j << "] = ";
+			}
+
+			code << getActivationCode(unitType, slope, amplify, unitInput.str()) << ";" << endl;
+		}
+
+		if(i < numHidden)
+		{
+			code << endl;
+		}
+	}
+
+	code << "\t}" << endl;
+	code << "}" << endl;
+	code << endl;
+	code << "#if defined(__GNUC__) && !defined(__clang__)" << endl;
+	code << "#pragma GCC pop_options" << endl;
+	code << "#endif" << endl;
+
+	source = code.str();
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// generates a header file for a network and writes it to a file
+/// </summary>
+/// <param name="net">the network</param>
+/// <param name="name">the namespace name (must be a valid C++ identifier)</param>
+/// <param name="fname">the file to write the header to</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NNetCodeGen::writeHeader(const NeuralNet& net, const string& name, const string& fname) const
+{
+	string source;
+
+	if(generateHeader(net, name, source) != 0)
+	{
+		return -1;
+	}
+
+	ofstream outFile(fname);
+
+	if(outFile.good())
+	{
+		outFile << source;
+	}
+	else
+	{
+		return -1;
+	}
+
+	outFile.close();
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Private Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// generates the expression applying an activation function to a unit
+/// input - the expressions follow NNetUnit::calcActivation term by
+/// term so they give identical results
+/// </summary>
+/// <param name="unitType">the activation function type</param>
+/// <param name="slope">the activation function slope value</param>
+/// <param name="amplify">the activation function amplify value</param>
+/// <param name="input">the name of the unit input variable</param>
+/// <returns>the expression</returns>
+/// 
+string NNetCodeGen::getActivationCode(ActiveT unitType, double slope, double amplify, const string& input)
+{
+	string x = input;
+	string s = toLiteral(slope);
+	string sx = (slope == 1.0) ? x : "(" + s + " * " + x + ")";
+	string nsx = (slope == 1.0) ? "-" + x : (slope < 0 ? "-(" + s + ")" : "-" + s) + " * " + x;
+	string expr;
+
+	switch(unitType)
+	{
+	case kUnipolar:
+		expr = "1.0 / (1.0 + std::exp(" + nsx + "))";
+		break;
+
+	case kBipolar:
+		expr = "(2.0 / (1.0 + std::exp(" + nsx + "))) - 1";
+		break;
+
+	case kTanh:
+		expr = "std::tanh(" + sx + ")";
+		break;
+
+	case kGauss:
+		expr = "std::exp(" + nsx + " * " + x + ")";
+		break;
+
+	case kArctan:
+		expr = "std::atan(" + sx + ")";
+		break;
+
+	case kSin:
+		expr = "std::sin(" + sx + ")";
+		break;
+
+	case kCos:
+		expr = "std::cos(" + sx + ")";
+		break;
+
+	case kSinC:
+		expr = "(std::fabs(" + x + ") < 0.00001 ? 1.0 : std::sin(" + sx + ") / " + sx + ")";
+		break;
+
+	case kElliot:
+		expr = "(" + sx + " / 2) / (1 + std::fabs(" + sx + ")) + 0.5";
+		break;
+
+	case kLinear:
+		expr = sx;
+		break;
+
+	case kISRU:
+		expr = x + " / std::sqrt(1 + " + (slope == 1.0 ? x : s + " * " + x) + " * " + x + ")";
+		break;
+
+	case kSoftSign:
+		expr = sx + " / (1 + std::fabs(" + sx + "))";
+		break;
+
+	case kSoftPlus:
+		expr = "std::log(1 + std::exp(" + sx + "))";
+		break;
+
+	default:	// threshold - also used for unknown types as by NNetUnit::getActivationFunction
+		expr = "(" + x + " >= 0 ? " + s + " : 0.0)";
+		break;
+	}
+
+	if(amplify != 1.0)
+	{
+		expr = toLiteral(amplify) + " * (" + expr + ")";
+	}
+
+	return expr;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// converts a value to a C++ double literal - 17 significant digits
+/// are enough to reproduce any double exactly. The value is formatted
+/// in the "C" locale as a literal always has a decimal point.
+/// </summary>
+/// <param name="value">the value</param>
+/// <returns>the literal</returns>
+/// 
+string NNetCodeGen::toLiteral(double value)
+{
+	char buffer[32];
+
+	NNetLocale::formatText(buffer, sizeof(buffer), "%.17g", value);
+
+	string literal = buffer;
+
+	// make sure the literal is a double rather than an integer
+	if(literal.find_first_of(".eEn") == string::npos)
+	{
+		literal += ".0";
+	}
+
+	return literal;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// checks that a name can be used as a C++ identifier
+/// </summary>
+/// <param name="name">the name</param>
+/// <returns>true if the name is a valid identifier</returns>
+/// 
+bool NNetCodeGen::isIdentifier(const string& name)
+{
+	if(name.empty() || isdigit((unsigned char)name[0]))
+	{
+		return false;
+	}
+
+	for(int i = 0; i < (int)name.size(); i++)
+	{
+		if(!isalnum((unsigned char)name[i]) && name[i] != '_')
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
@@ -0,0 +1,55 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NNetCodeGen class
+//
+// Author: Jason Jenkins
+//
+// This class generates a self-contained C++ header file from a
+// trained neural network (NeuralNet).
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <string>
+
+/////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////
+
+#include "NeuralNet.h"
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class generates a self-contained C++ header file from a
+/// trained neural network (NeuralNet).
+/// </summary>
+/// 
+class NNetCodeGen
+{
+public:
+	NNetCodeGen();
+	virtual ~NNetCodeGen();
+
+	// generates the C++ source code of a header file for a network
+	int generateHeader(const NeuralNet& net, const string& name, string& source) const;
+
+	// generates a header file for a network and writes it to a file
+	int writeHeader(const NeuralNet& net, const string& name, const string& fname) const;
+
+private:
+	// generates the expression applying an activation function to a unit input
+	static string getActivationCode(ActiveT unitType, double slope, double amplify, const string& input);
+
+	// converts a value to a C++ double literal that reproduces it exactly
+	static string toLiteral(double value);
+
+	// checks that a name can be used as a C++ identifier
+	static bool isIdentifier(const string& name);
+};
+
+/////////////////////////////////////////////////////////////////////
@@ -0,0 +1,447 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Implements the NNetEnsemble class
+//
+// Author: Jason Jenkins
+//
+// This class holds an ensemble of neural networks (NeuralNet) with
+// the same inputs and outputs and evaluates all of them together.
+//
+// Averaging the responses of several networks trained with different
+// random starting weights or activation settings usually gives a more
+// reliable prediction than any one of them, and the spread of their
+// responses gives an indication of its uncertainty. Calling
+// getResponse on each network in turn repeats a lot of work though -
+// every network reads the same inputs and most of the work is in the
+// first hidden layer.
+//
+// An ensemble stacks the first hidden layer weights of all its
+// networks into one tall matrix so each input row is read once and
+// multiplied by every network's first layer in a single pass. The
+// remaining layers of each network are held as a frozen network
+// (NNetFrozen). Input rows are processed a block at a time with each
+// weight applied to every row in the block in a single loop. The networks may have different numbers of hidden layers,
+// units and activation functions - they only need the same number of
+// inputs and outputs.
+/*
+		NNetEnsemble ensemble;
+
+		for(int i = 0; i < (int)nets.size(); i++)
+		{
+			ensemble.addNetwork(nets[i]);
+		}
+
+		// the inputs hold the input rows one after another
+		vector<double> means, variances;
+		ensemble.getMeanResponses(inputs, means, variances);
+*/
+// The networks are copied when they are added so later changes to
+// a network (further training for example) do not affect the ensemble.
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetEnsemble.h"
+
+/////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+/////////////////////////////////////////////////////////////////////
+/// The number of input rows processed together - every weight is 
+/// applied to all the rows of a block in one pass
+
+static const int kEnsembleBlockRows = 64;
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// default constructor
+/// </summary>
+/// 
+NNetEnsemble::NNetEnsemble()
+{
+	clearEnsemble();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// destructor
+/// </summary>
+/// 
+NNetEnsemble::~NNetEnsemble()
+{
+}
+
+/////////////////////////////////////////////////////////////////////
+// Public Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// clears the ensemble ready for re-use
+/// </summary>
+/// 
+void NNetEnsemble::clearEnsemble()
+{
+	mNumInputs = 0;
+	mNumOutputs = 0;
+	mNumFirstUnits = 0;
+	mMaxLayerSize = 0;
+
+	mFirstWeights.clear();
+	mFirstStarts.clear();
+	mFirstSizes.clear();
+	mFirstTypes.clear();
+	mFirstSlope.clear();
+	mFirstAmplify.clear();
+	mMembers.clear();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// adds a network to the ensemble - the network must have the same
+/// number of inputs and outputs as the networks already added
+/// </summary>
+/// <param name="net">the network to be added</param>
+/// <returns>0 if the network is added otherwise -1</returns>
+/// 
+int NNetEnsemble::addNetwork(const NeuralNet& net)
+{
+	int numHidden = net.getNumLayers();
+
+	if(numHidden < 1 || net.getNumInputs() <= 0 || net.getNumOutputs() <= 0)
+	{
+		return -1;
+	}
+
+	if(!mMembers.empty() && (net.getNumInputs() != mNumInputs || net.getNumOutputs() != mNumOutputs))
+	{
+		return -1;
+	}
+
+	const NNetWeightedConnect& connect = net.getWeightedConnect(0);
+	NNetFrozen member;
+	ActiveT unitType;
+	double slope, amplify;
+
+	// the layers after the first hidden layer are frozen
+	member.setNumInputs(connect.getNumOutputNodes());
+
+	for(int i = 1; i <= numHidden; i++)		// use <= to include the output layer
+	{
+		const NNetWeightedConnect& layer = net.getWeightedConnect(i);
+
+		unitType = net.getOutputUnitType();
+		slope = net.getOutputUnitSlope();
+		amplify = net.getOutputUnitAmplify();
+
+		if(i < numHidden)
+		{
+			net.getLayerDetails(i, unitType, slope, amplify);
+		}
+
+		if(member.addLayer(layer, unitType, slope, amplify) != 0)
+		{
+			return -1;
+		}
+	}
+
+	for(int i = 0; i < member.getNumLayers() + 1; i++)
+	{
+		mMaxLayerSize = max(mMaxLayerSize, member.getLayerSize(i));
+	}
+
+	// the first hidden layer is appended to the stacked matrix
+	int nUnits = connect.getNumOutputNodes();
+	vector<double> weights;
+
+	net.getLayerDetails(0, unitType, slope, amplify);
+
+	for(int i = 0; i < nUnits; i++)
+	{
+		connect.getWeightVector(i, weights);
+		mFirstWeights.insert(mFirstWeights.end(), weights.begin(), weights.end());
+	}
+
+	mNumInputs = net.getNumInputs();
+	mNumOutputs = net.getNumOutputs();
+
+	mFirstStarts.push_back(mNumFirstUnits);
+	mFirstSizes.push_back(nUnits);
+	mFirstTypes.push_back(unitType);
+	mFirstSlope.push_back(slope);
+	mFirstAmplify.push_back(amplify);
+	mMembers.push_back(member);
+
+	mNumFirstUnits += nUnits;
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the response of every network to a batch of input rows - the
+/// inputs vector holds the input rows one after another and for each
+/// row the outputs vector receives the outputs of the first network
+/// followed by those of the second network and so on
+/// </summary>
+/// <param name="inputs">the input rows</param>
+/// <param name="outputs">the network outputs for each row</param>
+/// 
+void NNetEnsemble::getMemberResponses(const vector<double>& inputs, vector<double>& outputs) const
+{
+	if(mNumInputs > 0)
+	{
+		int numRows = (int)inputs.size() / mNumInputs;
+
+		outputs.resize((size_t)numRows * mMembers.size() * mNumOutputs);
+
+		getMemberResponses(inputs.data(), outputs.data(), numRows);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the response of every network to a batch of input rows
+/// </summary>
+/// <param name="inputs">the input rows (numRows x the number of inputs)</param>
+/// <param name="outputs">the network outputs for each row
+///                       (numRows x the number of networks x the number of outputs)</param>
+/// <param name="numRows">the number of rows</param>
+/// 
+void NNetEnsemble::getMemberResponses(const double* inputs, double* outputs, int numRows) const
+{
+	vector<double> firstLayer, laneValues;
+	int rowOutputs = (int)mMembers.size() * mNumOutputs;
+
+	if(mMembers.empty())
+	{
+		return;
+	}
+
+	for(int r = 0; r < numRows; r += kEnsembleBlockRows)
+	{
+		int nBlock = min(kEnsembleBlockRows, numRows - r);
+
+		getBlockResponses(inputs + (size_t)r * mNumInputs, outputs + (size_t)r * rowOutputs,
+						  nBlock, firstLayer, laneValues);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the mean and variance of the network responses to a batch of
+/// input rows - the inputs vector holds the input rows one after
+/// another and the means and variances vectors receive one row of
+/// values (one for each output unit) for each input row
+/// </summary>
+/// <param name="inputs">the input rows</param>
+/// <param name="means">the mean network outputs for each row</param>
+/// <param name="variances">the variance of the network outputs for each row</param>
+/// 
+void NNetEnsemble::getMeanResponses(const vector<double>& inputs, vector<double>& means,
+									vector<double>& variances) const
+{
+	if(mNumInputs > 0)
+	{
+		int numRows = (int)inputs.size() / mNumInputs;
+
+		means.resize((size_t)numRows * mNumOutputs);
+		variances.resize((size_t)numRows * mNumOutputs);
+
+		getMeanResponses(inputs.data(), means.data(), variances.data(), numRows);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the mean and variance of the network responses to a batch of
+/// input rows - the variance is the mean squared difference between
+/// the network outputs and their mean
+/// </summary>
+/// <param name="inputs">the input rows (numRows x the number of inputs)</param>
+/// <param name="means">the mean outputs (numRows x the number of outputs)</param>
+/// <param name="variances">the output variances (numRows x the number of outputs) -
+///                         may be null if the variances are not required</param>
+/// <param name="numRows">the number of rows</param>
+/// 
+void NNetEnsemble::getMeanResponses(const double* inputs, double* means, double* variances, int numRows) const
+{
+	vector<double> firstLayer, laneValues, outputs;
+	int numMembers = (int)mMembers.size();
+	int rowOutputs = numMembers * mNumOutputs;
+
+	if(mMembers.empty())
+	{
+		return;
+	}
+
+	for(int r = 0; r < numRows; r += kEnsembleBlockRows)
+	{
+		int nBlock = min(kEnsembleBlockRows, numRows - r);
+
+		outputs.resize((size_t)nBlock * rowOutputs);
+
+		getBlockResponses(inputs + (size_t)r * mNumInputs, outputs.data(), nBlock, firstLayer, laneValues);
+
+		for(int b = 0; b < nBlock; b++)
+		{
+			const double* rowValues = outputs.data() + (size_t)b * rowOutputs;
+			size_t outIdx = (size_t)(r + b) * mNumOutputs;
+
+			for(int k = 0; k < mNumOutputs; k++)
+			{
+				double sum = 0, sumSq = 0;
+
+				for(int m = 0; m < numMembers; m++)
+				{
+					sum += rowValues[m * mNumOutputs + k];
+				}
+
+				double mean = sum / numMembers;
+
+				for(int m = 0; m < numMembers; m++)
+				{
+					double diff = rowValues[m * mNumOutputs + k] - mean;
+
+					sumSq += diff * diff;
+				}
+
+				means[outIdx + k] = mean;
+
+				if(variances != NULL)
+				{
+					variances[outIdx + k] = sumSq / numMembers;
+				}
+			}
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+// Private Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the response of every network to a block of input rows - 
+/// 
+/// The block is held in lane order (all the rows for the first value
+/// followed by all the rows for the second value and so on) so every
+/// weight is applied to the whole block in one vectorisable loop. The
+/// stacked first layer matrix is applied in a single pass leaving each
+/// network's first layer values contiguous, ready to be activated and
+/// passed through its remaining layers.
+/// </summary>
+/// <param name="inputs">the input rows</param>
+/// <param name="outputs">the network outputs for each row</param>
+/// <param name="numRows">the number of rows in the block (at most kEnsembleBlockRows)</param>
+/// <param name="firstLayer">working buffer for the first layer values</param>
+/// <param name="laneValues">working buffer for the inputs and the later layer values</param>
+/// 
+void NNetEnsemble::getBlockResponses(const double* inputs, double* outputs, int numRows,
+									 vector<double>& firstLayer, vector<double>& laneValues) const
+{
+	int numMembers = (int)mMembers.size();
+	int rowOutputs = numMembers * mNumOutputs;
+	int layerSize = mMaxLayerSize * numRows;
+
+	firstLayer.resize((size_t)mNumFirstUnits * numRows);
+	laneValues.resize((size_t)mNumInputs * numRows + 2 * layerSize);
+
+	double* laneInputs = laneValues.data();
+	double acc[kEnsembleBlockRows];
+
+	// copy the rows into lane order
+	for(int r = 0; r < numRows; r++)
+	{
+		for(int j = 0; j < mNumInputs; j++)
+		{
+			laneInputs[j * numRows + r] = inputs[(size_t)r * mNumInputs + j];
+		}
+	}
+
+	// apply the stacked first layer matrix to the whole block
+	const double* weights = mFirstWeights.data();
+
+	for(int u = 0; u < mNumFirstUnits; u++)
+	{
+		for(int r = 0; r < numRows; r++)
+		{
+			acc[r] = 0;
+		}
+
+		for(int j = 0; j < mNumInputs; j++)
+		{
+			double w = weights[j];
+			const double* x = laneInputs + j * numRows;
+
+			for(int r = 0; r < numRows; r++)
+			{
+				acc[r] += w * x[r];
+			}
+		}
+
+		copy(acc, acc + numRows, firstLayer.begin() + (size_t)u * numRows);
+		weights += mNumInputs;
+	}
+
+	for(int m = 0; m < numMembers; m++)
+	{
+		const NNetFrozen& member = mMembers[m];
+		double* layerInputs = firstLayer.data() + (size_t)mFirstStarts[m] * numRows;
+		ActiveT unitType;
+		double slope, amplify;
+
+		// activate the network's first layer
+		NNetUnit::getActivationFunction(mFirstTypes[m])(layerInputs, layerInputs, mFirstSizes[m] * numRows, 
+														 mFirstSlope[m], mFirstAmplify[m]);
+
+		// apply the remaining layers
+		for(int i = 0; i < member.getNumLayers() + 1; i++)
+		{
+			int nIn = member.getLayerInputs(i);
+			int nOut = member.getLayerSize(i);
+			double* layerOutputs = laneValues.data() + (size_t)mNumInputs * numRows + (i % 2) * layerSize;
+
+			weights = member.getLayerWeights(i);
+
+			for(int u = 0; u < nOut; u++)
+			{
+				for(int r = 0; r < numRows; r++)
+				{
+					acc[r] = 0;
+				}
+
+				for(int j = 0; j < nIn; j++)
+				{
+					double w = weights[j];
+					const double* x = layerInputs + j * numRows;
+
+					for(int r = 0; r < numRows; r++)
+					{
+						acc[r] += w * x[r];
+					}
+				}
+
+				copy(acc, acc + numRows, layerOutputs + u * numRows);
+				weights += nIn;
+			}
+
+			member.getLayerDetails(i, unitType, slope, amplify);
+			NNetUnit::getActivationFunction(unitType)(layerOutputs, layerOutputs, nOut * numRows, slope, amplify);
+
+			layerInputs = layerOutputs;
+		}
+
+		// copy the network outputs back into row order
+		for(int r = 0; r < numRows; r++)
+		{
+			for(int k = 0; k < mNumOutputs; k++)
+			{
+				outputs[(size_t)r * rowOutputs + m * mNumOutputs + k] = layerInputs[k * numRows + r];
+			}
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
@@ -0,0 +1,112 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NNetEnsemble class
+//
+// Author: Jason Jenkins
+//
+// This class holds an ensemble of neural networks (NeuralNet) with
+// the same inputs and outputs and evaluates all of them together.
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////
+
+#include "NeuralNet.h"
+#include "NNetFrozen.h"
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class holds an ensemble of neural networks (NeuralNet) with
+/// the same inputs and outputs and evaluates all of them together.
+/// </summary>
+/// 
+class NNetEnsemble
+{
+public:
+	NNetEnsemble();
+	virtual ~NNetEnsemble();
+
+	// clears the ensemble ready for re-use
+	void clearEnsemble();
+
+	// adds a network to the ensemble
+	int addNetwork(const NeuralNet& net);
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of networks in the ensemble</returns>
+	int getNumMembers() const { return (int)mMembers.size(); }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of input units</returns>
+	int getNumInputs() const { return mNumInputs; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of output units of each network</returns>
+	int getNumOutputs() const { return mNumOutputs; }
+
+	// gets the response of every network to a batch of input rows
+	void getMemberResponses(const vector<double>& inputs, vector<double>& outputs) const;
+	void getMemberResponses(const double* inputs, double* outputs, int numRows) const;
+
+	// gets the mean and variance of the network responses to a batch of input rows
+	void getMeanResponses(const vector<double>& inputs, vector<double>& means,
+						  vector<double>& variances) const;
+	void getMeanResponses(const double* inputs, double* means, double* variances, int numRows) const;
+
+private:
+	// gets the response of every network to a block of input rows
+	void getBlockResponses(const double* inputs, double* outputs, int numRows,
+						   vector<double>& firstLayer, vector<double>& laneValues) const;
+
+private:
+	/// <summary>the number of input units</summary>
+	int mNumInputs;
+
+	/// <summary>the number of output units of each network</summary>
+	int mNumOutputs;
+
+	/// <summary>the total number of first hidden layer units of all the networks</summary>
+	int mNumFirstUnits;
+
+	/// <summary>the largest layer after the first hidden layer of all the networks</summary>
+	int mMaxLayerSize;
+
+	/// <summary>
+	/// the first hidden layer weights of all the networks stacked into
+	/// a single matrix - stored row by row, one row per unit
+	/// </summary>
+	vector<double> mFirstWeights;
+
+	/// <summary>the first row of each network's first hidden layer in the stacked matrix</summary>
+	vector<int> mFirstStarts;
+
+	/// <summary>the number of units in each network's first hidden layer</summary>
+	vector<int> mFirstSizes;
+
+	/// <summary>the first hidden layer unit activation function type of each network</summary>
+	vector<ActiveT> mFirstTypes;
+
+	/// <summary>the first hidden layer unit activation function slope value of each network</summary>
+	vector<double> mFirstSlope;
+
+	/// <summary>the first hidden layer unit activation function amplify value of each network</summary>
+	vector<double> mFirstAmplify;
+
+	/// <summary>the layers following the first hidden layer of each network</summary>
+	vector<NNetFrozen> mMembers;
+};
+
+/////////////////////////////////////////////////////////////////////
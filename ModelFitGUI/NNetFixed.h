@@ -0,0 +1,317 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NNetFixed class template
+//
+// Author: Jason Jenkins
+//
+// This class template is a representation of a trained feed forward
+// neural network whose topology is fixed at compile time.
+//
+// The numbers of input units, output units and units in each of the
+// hidden layers are template parameters, so all the weights and the
+// values passed between the layers are held in std::array members
+// with sizes known to the compiler. Every loop in the response 
+// calculation has a constant trip count and the compiler is free to
+// unroll them completely and keep the layer values in registers. For
+// the small networks built by the ModelFitGUI application the whole
+// model fits comfortably within the L1 cache.
+//
+// The weights and activation settings are loaded from a trained 
+// network - either a NeuralNet object, its frozen form or a file 
+// written by NeuralNet::writeToFile. Loading fails if the network 
+// does not have the topology given by the template parameters. The 
+// following code loads the single hidden layer network with 10 units
+// fitted by the application and calculates a response:
+/*
+		NNetFixed<1, 1, 10> model;		// 1 input, 1 output, 10 hidden units
+
+		if(model.readFromFile("Wage_TrainedNetwork.net") == 0)
+		{
+			std::array<double, 1> x = { 0.045 };
+			std::array<double, 1> y;
+
+			model.getResponse(x, y);
+		}
+*/
+// Networks with several hidden layers list the layer sizes in order,
+// e.g. NNetFixed<2, 3, 4, 6> has 2 inputs, 3 outputs and two hidden 
+// layers with 4 and 6 units respectively.
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <string>
+
+/////////////////////////////////////////////////////////////////////
+
+#include "NeuralNet.h"
+#include "NNetFrozen.h"
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// A single layer of a fixed topology network - the weighted 
+/// connections from NIn units into the NOut units of the layer and 
+/// the layer's activation settings.
+/// </summary>
+/// 
+template<int NIn, int NOut>
+class NNetFixedLayer
+{
+public:
+	NNetFixedLayer() : mUnitType(kThreshold), mSlope(1.0), mAmplify(1.0)
+	{
+		mWeights.fill(0.0);
+	}
+
+	/// <summary>
+	/// loads the specified layer of a frozen network
+	/// </summary>
+	/// <returns>0 if successful or -1 if the layer sizes do not match</returns>
+	int load(const NNetFrozen& frozen, int layer)
+	{
+		if(frozen.getLayerInputs(layer) != NIn || frozen.getLayerSize(layer) != NOut)
+		{
+			return -1;
+		}
+
+		// layers stored as 16 bit values are widened to doubles
+		frozen.getLayerWeights(layer, mWeights.data());
+
+		frozen.getLayerDetails(layer, mUnitType, mSlope, mAmplify);
+
+		return 0;
+	}
+
+	/// <summary>
+	/// calculates the activation values of the layer units
+	/// </summary>
+	void apply(const double* inputs, std::array<double, NOut>& outputs) const
+	{
+		for(int j = 0; j < NOut; j++)
+		{
+			double value = 0;
+
+			for(int k = 0; k < NIn; k++)
+			{
+				value += mWeights[j * NIn + k] * inputs[k];
+			}
+
+			outputs[j] = value;
+		}
+
+		activate(outputs);
+	}
+
+private:
+	/// <summary>
+	/// applies the layer activation function to the unit input values - 
+	/// the switch picks a loop in which the activation function is known
+	/// to the compiler so it is inlined rather than called through a 
+	/// pointer
+	/// </summary>
+	/// <param name="values">the unit input values - replaced by the activation values</param>
+	void activate(std::array<double, NOut>& values) const
+	{
+		switch(mUnitType)
+		{
+		case kThreshold:	activate<kThreshold>(values);	break;
+		case kUnipolar:		activate<kUnipolar>(values);	break;
+		case kBipolar:		activate<kBipolar>(values);		break;
+		case kTanh:			activate<kTanh>(values);		break;
+		case kGauss:		activate<kGauss>(values);		break;
+		case kArctan:		activate<kArctan>(values);		break;
+		case kSin:			activate<kSin>(values);			break;
+		case kCos:			activate<kCos>(values);			break;
+		case kSinC:			activate<kSinC>(values);		break;
+		case kElliot:		activate<kElliot>(values);		break;
+		case kLinear:		activate<kLinear>(values);		break;
+		case kISRU:			activate<kISRU>(values);		break;
+		case kSoftSign:		activate<kSoftSign>(values);	break;
+		case kSoftPlus:		activate<kSoftPlus>(values);	break;
+		}
+	}
+
+	/// <summary>
+	/// applies the given activation function to the unit input values - 
+	/// as in the activation kernels a slope and amplify of 1 are passed
+	/// as constants so the multiplications by them are removed
+	/// </summary>
+	/// <param name="values">the unit input values - replaced by the activation values</param>
+	template<ActiveT unitType>
+	void activate(std::array<double, NOut>& values) const
+	{
+		if(mSlope == 1.0 && mAmplify == 1.0)
+		{
+			for(int j = 0; j < NOut; j++)
+			{
+				values[j] = NNetUnit::calcActivation<unitType>(1.0, 1.0, values[j]);
+			}
+		}
+		else
+		{
+			for(int j = 0; j < NOut; j++)
+			{
+				values[j] = NNetUnit::calcActivation<unitType>(mSlope, mAmplify, values[j]);
+			}
+		}
+	}
+
+private:
+	/// <summary>the weighted connections stored row by row - one row per unit</summary>
+	std::array<double, NIn * NOut> mWeights;
+
+	/// <summary>the layer unit activation function type</summary>
+	ActiveT mUnitType;
+
+	/// <summary>the layer activation function slope value</summary>
+	double mSlope;
+
+	/// <summary>the layer activation function amplify value</summary>
+	double mAmplify;
+};
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// A chain of fixed topology layers - NIn inputs followed by the unit
+/// counts of each layer in turn. Each link holds one layer and the 
+/// rest of the chain.
+/// </summary>
+/// 
+template<int NIn, int... NLayers>
+class NNetFixedChain;
+
+/// <summary>the last layer in the chain (the output layer)</summary>
+template<int NIn, int NOut>
+class NNetFixedChain<NIn, NOut>
+{
+public:
+	enum { kNumOutputs = NOut };
+
+	int load(const NNetFrozen& frozen, int layer) 
+	{ 
+		return mLayer.load(frozen, layer); 
+	}
+
+	void apply(const double* inputs, std::array<double, NOut>& outputs) const 
+	{ 
+		mLayer.apply(inputs, outputs); 
+	}
+
+private:
+	NNetFixedLayer<NIn, NOut> mLayer;
+};
+
+/// <summary>a hidden layer followed by the rest of the chain</summary>
+template<int NIn, int N1, int N2, int... NRest>
+class NNetFixedChain<NIn, N1, N2, NRest...>
+{
+public:
+	typedef NNetFixedChain<N1, N2, NRest...> NextChain;
+
+	enum { kNumOutputs = NextChain::kNumOutputs };
+
+	int load(const NNetFrozen& frozen, int layer)
+	{
+		if(mLayer.load(frozen, layer) != 0) return -1;
+
+		return mNext.load(frozen, layer + 1);
+	}
+
+	void apply(const double* inputs, std::array<double, kNumOutputs>& outputs) const
+	{
+		std::array<double, N1> values;
+
+		mLayer.apply(inputs, values);
+		mNext.apply(values.data(), outputs);
+	}
+
+private:
+	NNetFixedLayer<NIn, N1> mLayer;
+	NextChain mNext;
+};
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class template is a representation of a trained feed forward
+/// neural network whose topology is fixed at compile time.
+/// </summary>
+/// 
+template<int NIn, int NOut, int... NHidden>
+class NNetFixed
+{
+	static_assert(sizeof...(NHidden) > 0, "NNetFixed requires at least one hidden layer");
+
+public:
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of input units</returns>
+	static int getNumInputs() { return NIn; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of output units</returns>
+	static int getNumOutputs() { return NOut; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of hidden layers</returns>
+	static int getNumLayers() { return (int)sizeof...(NHidden); }
+
+	/// <summary>
+	/// loads the weights and activation settings from a frozen network
+	/// </summary>
+	/// <param name="frozen">the frozen network</param>
+	/// <returns>0 if successful or -1 if the topologies do not match</returns>
+	int load(const NNetFrozen& frozen)
+	{
+		if(frozen.getNumInputs() != NIn || frozen.getNumLayers() != getNumLayers())
+		{
+			return -1;
+		}
+
+		return mLayers.load(frozen, 0);
+	}
+
+	/// <summary>
+	/// loads the weights and activation settings from a network
+	/// </summary>
+	/// <param name="net">the network</param>
+	/// <returns>0 if successful or -1 if the topologies do not match</returns>
+	int load(const NeuralNet& net)
+	{
+		return load(net.freeze());
+	}
+
+	/// <summary>
+	/// loads the weights and activation settings from a file written 
+	/// by NeuralNet::writeToFile
+	/// </summary>
+	/// <param name="fname">the file containing the serialized network</param>
+	/// <returns>0 if successful or -1 if the topologies do not match</returns>
+	int readFromFile(const std::string& fname)
+	{
+		NeuralNet net(fname);
+
+		return load(net);
+	}
+
+	/// <summary>
+	/// gets the response of the network to the given input
+	/// </summary>
+	/// <param name="inputs">the network input values</param>
+	/// <param name="outputs">the network output values</param>
+	void getResponse(const std::array<double, NIn>& inputs, std::array<double, NOut>& outputs) const
+	{
+		mLayers.apply(inputs.data(), outputs);
+	}
+
+private:
+	/// <summary>the hidden layers followed by the output layer</summary>
+	NNetFixedChain<NIn, NHidden..., NOut> mLayers;
+};
+
+/////////////////////////////////////////////////////////////////////
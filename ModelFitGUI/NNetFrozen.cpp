@@ -0,0 +1,940 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Implements the NNetFrozen class
+//
+// Author: Jason Jenkins
+//
+// This class is a compact, read only representation of a trained
+// feed forward neural network that is optimised for calculating 
+// responses.
+//
+// Once training is complete a network is only needed to calculate
+// responses. A NeuralNet object still carries everything required
+// by the training process: an NNetWeightedConnect object for each
+// layer (with its own input and output buffers), the activation and
+// unit input values of the last response and so on. Calling the
+// NeuralNet::freeze method produces an NNetFrozen object containing
+// only what is needed to calculate a response:
+//
+// - the weights of every layer packed one after another into a 
+//   single buffer, with the offset of each layer precomputed;
+//
+// - the activation kernel of each layer, resolved once from its 
+//   activation function type (see NNetUnit::getActivationFunction),
+//   along with the layer's slope and amplify values.
+//
+// The frozen network is never modified once it has been built so it
+// can be shared freely between threads. The caller supplies a small
+// scratch buffer, getScratchSize() values long, which is used to hold
+// the values passed between the layers:
+/*
+		NNetFrozen frozen = net.freeze();
+		vector<double> scratch, outputs;
+
+		frozen.getResponse(inputs, outputs, scratch);
+*/
+// Networks with a single input and a handful of hidden units, like
+// those fitted by the ModelFitGUI application, are too narrow for 
+// the vector units to be used effectively within a layer. So when
+// scoring a batch of rows the getResponses method evaluates 4, 8 or
+// 16 rows (lanes) together instead: every value passed between the 
+// layers is stored lane by lane so each step of the calculation is
+// a short loop over the lanes that the compiler can vectorise, with
+// each lane running through the whole network.
+//
+// A frozen network can also be opened straight from a binary network
+// file. The file is mapped into memory and the weights are used in 
+// place, so scoring processes started on the same machine share one
+// copy of the weights through the page cache and start up at once:
+/*
+		net.writeToBinaryFile("network.bin");		// once, after training
+
+		NNetFrozen frozen;							// in each scoring process
+		frozen.openMapped("network.bin");
+*/
+// The weights of each layer can also be stored as 16 bit fp16 or bf16
+// values (see NNetHalf), either when the network is frozen or in a
+// binary network file, which quarters the size of the weights. The 
+// weights are widened as they are used so the sums are accumulated in
+// double precision as before. Layers that are sensitive to rounding 
+// can be kept in double precision and getPrecisionReport shows what
+// the reduced precision costs:
+/*
+		vector<ScalarT> layerScalars = { kFloat16, kFloat64 };	// a compact hidden layer
+		NNetFrozen frozen = net.freeze(layerScalars);
+
+		cout << frozen.getPrecisionReport(net, sampleInputs);
+*/
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetFrozen.h"
+#include "NNetMappedFile.h"
+#include "NNetBinaryFormat.h"
+#include "NeuralNet.h"
+
+/////////////////////////////////////////////////////////////////////
+
+#include <limits.h>
+#include <math.h>
+#include <sstream>
+
+/////////////////////////////////////////////////////////////////////
+/// The weight readers used by the kernels - each widens a weight of
+/// one storage type to a double
+
+struct NNetDoubleReader
+{
+	typedef double StoredT;
+	static double get(double weight) { return weight; }
+};
+
+struct NNetFloat16Reader
+{
+	typedef unsigned short StoredT;
+	static double get(unsigned short weight) { return NNetHalf::fromFloat16(weight); }
+};
+
+struct NNetBFloat16Reader
+{
+	typedef unsigned short StoredT;
+	static double get(unsigned short weight) { return NNetHalf::fromBFloat16(weight); }
+};
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// applies the weighted connections of a layer to a single set of 
+/// layer inputs
+/// </summary>
+/// <param name="weights">the layer weights stored row by row</param>
+/// <param name="inputs">the layer input values</param>
+/// <param name="outputs">receives the weighted sum for each unit</param>
+/// <param name="nIn">the number of layer inputs</param>
+/// <param name="nOut">the number of layer units</param>
+/// 
+template<typename R>
+static void applyWeights(const typename R::StoredT* weights, const double* inputs, 
+						 double* outputs, int nIn, int nOut)
+{
+	for(int j = 0; j < nOut; j++)
+	{
+		double value = 0;
+
+		for(int k = 0; k < nIn; k++)
+		{
+			value += R::get(weights[k]) * inputs[k];
+		}
+
+		outputs[j] = value;
+		weights += nIn;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// applies the weighted connections of a layer to L sets of layer 
+/// inputs stored lane by lane
+/// </summary>
+/// <param name="weights">the layer weights stored row by row</param>
+/// <param name="inputs">the lane ordered layer input values</param>
+/// <param name="outputs">receives the lane ordered weighted sums</param>
+/// <param name="nIn">the number of layer inputs</param>
+/// <param name="nOut">the number of layer units</param>
+/// 
+template<int L, typename R>
+static void applyLaneWeights(const typename R::StoredT* weights, const double* inputs, 
+							 double* outputs, int nIn, int nOut)
+{
+	for(int j = 0; j < nOut; j++)
+	{
+		double* values = outputs + j * L;
+
+		for(int l = 0; l < L; l++)
+		{
+			values[l] = 0;
+		}
+
+		for(int k = 0; k < nIn; k++)
+		{
+			double w = R::get(weights[k]);
+			const double* x = inputs + k * L;
+
+			for(int l = 0; l < L; l++)
+			{
+				values[l] += w * x[l];
+			}
+		}
+
+		weights += nIn;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// default constructor
+/// </summary>
+/// 
+NNetFrozen::NNetFrozen()
+{
+	mNumInputs = 0;
+	mMaxLayerSize = 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// destructor
+/// </summary>
+///
+NNetFrozen::~NNetFrozen()
+{
+}
+
+/////////////////////////////////////////////////////////////////////
+// Public Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// clears a NNetFrozen object ready for re-use
+/// </summary>
+/// 
+void NNetFrozen::clearFrozenNet()
+{
+	mNumInputs = 0;
+	mMaxLayerSize = 0;
+
+	mWeights.clear();
+	mHalfWeights.clear();
+	mLayerOffsets.clear();
+	mLayerScalars.clear();
+	mMapping.reset();
+	mLayerSizes.clear();
+	mLayerTypes.clear();
+	mLayerKernels.clear();
+	mLayerSlope.clear();
+	mLayerAmplify.clear();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets the number of input units - this must be called before any 
+/// layers are added
+/// </summary>
+/// <param name="numInputs">the number of input units</param>
+///
+void NNetFrozen::setNumInputs(int numInputs)
+{
+	// ignore invalid values
+	if(numInputs > 0 && mLayerSizes.empty())
+	{
+		mNumInputs = numInputs;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// appends a layer to the network - 
+/// 
+/// The layers are added in order from the first hidden layer to the
+/// output layer. The weighted connections into the new layer must 
+/// have one input node for each unit of the previous layer (or each
+/// input unit for the first layer).
+/// </summary>
+/// <param name="connect">the weighted connections into the layer</param>
+/// <param name="unitType">the layer unit activation function type</param>
+/// <param name="slope">the layer unit activation function slope value</param>
+/// <param name="amplify">the layer unit activation function amplify value</param>
+/// <param name="scalarType">the type the layer's weights are stored as</param>
+/// 
+/// <returns>0 if the layer is successfully added otherwise -1</returns>
+/// 
+int NNetFrozen::addLayer(const NNetWeightedConnect& connect, ActiveT unitType, 
+						 double slope, double amplify, ScalarT scalarType)
+{
+	int nIn = connect.getNumInputNodes();
+	int nOut = connect.getNumOutputNodes();
+	int nPrev = mLayerSizes.empty() ? mNumInputs : mLayerSizes.back();
+
+	// the layers of a mapped network can not be added to
+	if(nIn <= 0 || nOut <= 0 || nIn != nPrev || isMapped())
+	{
+		return -1;
+	}
+
+	vector<double> weights;
+
+	mLayerOffsets.push_back((int)((scalarType == kFloat64) ? mWeights.size() : mHalfWeights.size()));
+	mLayerScalars.push_back(scalarType);
+
+	// pack the weights of the new layer after those of the previous layers
+	for(int i = 0; i < nOut; i++)
+	{
+		connect.getWeightVector(i, weights);
+
+		for(int j = 0; j < nIn; j++)
+		{
+			switch(scalarType)
+			{
+			case kFloat16:
+				mHalfWeights.push_back(NNetHalf::toFloat16(weights[j]));
+				break;
+
+			case kBFloat16:
+				mHalfWeights.push_back(NNetHalf::toBFloat16(weights[j]));
+				break;
+
+			default:
+				mWeights.push_back(weights[j]);
+				break;
+			}
+		}
+	}
+
+	mLayerSizes.push_back(nOut);
+	mLayerTypes.push_back(unitType);
+	mLayerKernels.push_back(NNetUnit::getActivationFunction(unitType));
+	mLayerSlope.push_back(slope);
+	mLayerAmplify.push_back(amplify);
+
+	mMaxLayerSize = max(mMaxLayerSize, nOut);
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// builds the network from a binary network file (see 
+/// NeuralNet::writeToBinaryFile) using the weights in place from a 
+/// read only mapping of the file - 
+/// 
+/// Nothing is copied so the network is ready almost at once however 
+/// large it is, and the weights are shared through the page cache by
+/// every process that opens the same file. The mapping is kept open 
+/// by the network and any copies of it. The checksum can be skipped
+/// to avoid reading the whole file when it is opened. On a big-endian 
+/// machine the weights can not be used in place so they are copied.
+/// 
+/// While it is mapped the file may only be replaced by renaming another
+/// file over it, as NeuralNet::writeToBinaryFile does - the network then
+/// keeps the old weights. A file rewritten in place changes the weights
+/// under the network, and reading past its new end raises SIGBUS. On 
+/// Windows a mapped file can not be replaced at all, so writing it fails
+/// and leaves it unchanged.
+/// </summary>
+/// <param name="fname">the binary network file</param>
+/// <param name="verifyChecksum">true to check the file against its checksum</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NNetFrozen::openMapped(const string& fname, bool verifyChecksum)
+{
+	shared_ptr<NNetMappedFile> mapping = make_shared<NNetMappedFile>();
+	NNetBinaryFormat format;
+
+	clearFrozenNet();
+
+	if(mapping->openFile(fname) != 0 ||
+	   mapping->getLength() / sizeof(unsigned short) > INT_MAX ||
+	   format.readLayout(mapping->getData(), mapping->getLength(), verifyChecksum) != 0)
+	{
+		return -1;
+	}
+
+	mNumInputs = format.getNumInputs();
+
+	for(int i = 0; i <= format.getNumLayers(); i++)		// use <= to include the output layer
+	{
+		int nOut = format.getLayerSize(i);
+		size_t pos = format.getWeightOffset(i);
+		ScalarT scalarType = format.getLayerScalarType(i);
+		size_t scalarSize = NNetHalf::getScalarSize(scalarType);
+
+		mLayerScalars.push_back(scalarType);
+
+		if(NNetBinaryFormat::isLittleEndian())
+		{
+			// the offset of the layer's weights from the start of the file
+			mLayerOffsets.push_back((int)(pos / scalarSize));
+		}
+		else
+		{
+			size_t numWeights = (size_t)format.getLayerInputs(i) * nOut;
+			void* weights;
+
+			if(scalarType == kFloat64)
+			{
+				mLayerOffsets.push_back((int)mWeights.size());
+				mWeights.resize(mWeights.size() + numWeights);
+				weights = mWeights.data() + mLayerOffsets.back();
+			}
+			else
+			{
+				mLayerOffsets.push_back((int)mHalfWeights.size());
+				mHalfWeights.resize(mHalfWeights.size() + numWeights);
+				weights = mHalfWeights.data() + mLayerOffsets.back();
+			}
+
+			NNetBinaryFormat::getValues(mapping->getData(), mapping->getLength(), pos, 
+										weights, scalarSize, numWeights);
+		}
+
+		mLayerSizes.push_back(nOut);
+		mLayerTypes.push_back(format.getLayerType(i));
+		mLayerKernels.push_back(NNetUnit::getActivationFunction(format.getLayerType(i)));
+		mLayerSlope.push_back(format.getLayerSlope(i));
+		mLayerAmplify.push_back(format.getLayerAmplify(i));
+
+		mMaxLayerSize = max(mMaxLayerSize, nOut);
+	}
+
+	if(NNetBinaryFormat::isLittleEndian())
+	{
+		mMapping = mapping;
+	}
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the number of units in the specified layer
+/// </summary>
+/// <param name="layer">the specified layer (getNumLayers() is the output layer)</param>
+/// <returns>the number of units in the layer or 0 if it does not exist</returns>
+/// 
+int NNetFrozen::getLayerSize(int layer) const
+{
+	if(layer >= 0 && layer < (int)mLayerSizes.size())
+	{
+		return mLayerSizes[layer];
+	}
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the number of inputs to the specified layer - this is the 
+/// size of the previous layer (or the number of input units)
+/// </summary>
+/// <param name="layer">the specified layer (getNumLayers() is the output layer)</param>
+/// <returns>the number of inputs to the layer or 0 if it does not exist</returns>
+/// 
+int NNetFrozen::getLayerInputs(int layer) const
+{
+	if(layer >= 0 && layer < (int)mLayerSizes.size())
+	{
+		return (layer == 0) ? mNumInputs : mLayerSizes[layer - 1];
+	}
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the packed weights of the connections into the specified 
+/// layer - the weights are stored row by row with one row of 
+/// getLayerInputs(layer) weights for each unit of the layer
+/// </summary>
+/// <param name="layer">the specified layer (getNumLayers() is the output layer)</param>
+/// <returns>the layer weights or NULL if the layer does not exist or is not stored as doubles</returns>
+/// 
+const double* NNetFrozen::getLayerWeights(int layer) const
+{
+	if(layer >= 0 && layer < (int)mLayerSizes.size() && mLayerScalars[layer] == kFloat64)
+	{
+		return getWeightBase() + mLayerOffsets[layer];
+	}
+
+	return NULL;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// copies the weights of the connections into the specified layer as
+/// doubles whatever type they are stored as - the weights are copied
+/// in the same order as they are stored
+/// </summary>
+/// <param name="layer">the specified layer (getNumLayers() is the output layer)</param>
+/// <param name="weights">receives getLayerInputs(layer) * getLayerSize(layer) weights</param>
+/// <returns>0 if successful or -1 if the layer does not exist</returns>
+/// 
+int NNetFrozen::getLayerWeights(int layer, double* weights) const
+{
+	if(layer < 0 || layer >= (int)mLayerSizes.size())
+	{
+		return -1;
+	}
+
+	size_t numWeights = (size_t)getLayerInputs(layer) * mLayerSizes[layer];
+
+	if(mLayerScalars[layer] == kFloat64)
+	{
+		const double* stored = getWeightBase() + mLayerOffsets[layer];
+
+		copy(stored, stored + numWeights, weights);
+	}
+	else
+	{
+		const unsigned short* stored = getHalfWeightBase() + mLayerOffsets[layer];
+
+		for(size_t i = 0; i < numWeights; i++)
+		{
+			weights[i] = (mLayerScalars[layer] == kFloat16) ? NNetHalf::fromFloat16(stored[i]) : 
+															  NNetHalf::fromBFloat16(stored[i]);
+		}
+	}
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the type the weights of the specified layer are stored as
+/// </summary>
+/// <param name="layer">the specified layer (getNumLayers() is the output layer)</param>
+/// <returns>the storage type of the layer weights (kFloat64 if the layer does not exist)</returns>
+/// 
+ScalarT NNetFrozen::getLayerScalarType(int layer) const
+{
+	if(layer >= 0 && layer < (int)mLayerSizes.size())
+	{
+		return mLayerScalars[layer];
+	}
+
+	return kFloat64;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the number of bytes used by the weights
+/// </summary>
+/// <returns>the number of bytes used by the weights</returns>
+/// 
+size_t NNetFrozen::getWeightBytes() const
+{
+	size_t numBytes = 0;
+
+	for(int i = 0; i < (int)mLayerSizes.size(); i++)
+	{
+		numBytes += (size_t)getLayerInputs(i) * mLayerSizes[i] * NNetHalf::getScalarSize(mLayerScalars[i]);
+	}
+
+	return numBytes;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the activation function details of the specified layer
+/// </summary>
+/// <param name="layer">the specified layer (getNumLayers() is the output layer)</param>
+/// <param name="unitType">the layer unit activation function type</param>
+/// <param name="slope">the layer unit activation function slope value</param>
+/// <param name="amplify">the layer unit activation function amplify value</param>
+/// 
+void NNetFrozen::getLayerDetails(int layer, ActiveT& unitType, double& slope, double& amplify) const
+{
+	if(layer >= 0 && layer < (int)mLayerSizes.size())
+	{
+		unitType = mLayerTypes[layer];
+		slope = mLayerSlope[layer];
+		amplify = mLayerAmplify[layer];
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the response of the network to the given input - 
+/// 
+/// The inputs buffer must hold one value for each input unit and the 
+/// outputs buffer one value for each output unit. The scratch buffer
+/// must hold getScratchSize() values and is used to pass the unit
+/// values from one layer to the next.
+/// </summary>
+/// <param name="inputs">the network input values</param>
+/// <param name="outputs">the network output values</param>
+/// <param name="scratch">a working buffer of getScratchSize() values</param>
+/// 
+void NNetFrozen::getResponse(const double* inputs, double* outputs, double* scratch) const
+{
+	int nLayers = (int)mLayerSizes.size();
+	int nIn = mNumInputs;
+	const double* layerInputs = inputs;
+
+	for(int i = 0; i < nLayers; i++)
+	{
+		int nOut = mLayerSizes[i];
+
+		// the hidden layers alternate between the two halves of the scratch 
+		// buffer and the output layer writes straight to the caller's buffer
+		double* layerOutputs = (i == nLayers - 1) ? outputs : scratch + (i % 2) * mMaxLayerSize;
+
+		// apply the weighted connections
+		switch(mLayerScalars[i])
+		{
+		case kFloat16:
+			applyWeights<NNetFloat16Reader>(getHalfWeightBase() + mLayerOffsets[i], layerInputs, layerOutputs, nIn, nOut);
+			break;
+
+		case kBFloat16:
+			applyWeights<NNetBFloat16Reader>(getHalfWeightBase() + mLayerOffsets[i], layerInputs, layerOutputs, nIn, nOut);
+			break;
+
+		default:
+			applyWeights<NNetDoubleReader>(getWeightBase() + mLayerOffsets[i], layerInputs, layerOutputs, nIn, nOut);
+			break;
+		}
+
+		// activate the layer units in place
+		mLayerKernels[i](layerOutputs, layerOutputs, nOut, mLayerSlope[i], mLayerAmplify[i]);
+
+		layerInputs = layerOutputs;
+		nIn = nOut;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the response of the network to the given input - 
+/// 
+/// The outputs and scratch vectors are resized as required so when 
+/// they are reused no memory is allocated.
+/// </summary>
+/// <param name="inputs">the network input values</param>
+/// <param name="outputs">the network output values</param>
+/// <param name="scratch">a reusable working buffer</param>
+/// 
+void NNetFrozen::getResponse(const vector<double>& inputs, vector<double>& outputs, 
+							 vector<double>& scratch) const
+{
+	if((int)inputs.size() >= mNumInputs && !mLayerSizes.empty())
+	{
+		if((int)scratch.size() < getScratchSize())
+		{
+			scratch.resize(getScratchSize());
+		}
+
+		outputs.resize(getNumOutputs());
+
+		getResponse(inputs.data(), outputs.data(), scratch.data());
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the responses of the network to a batch of input rows - 
+/// 
+/// The input matrix is stored row by row with one value for each input
+/// unit and the output matrix, which must be large enough to hold one
+/// value for each output unit per row, is filled in the same order. The
+/// rows are evaluated laneWidth (4, 8 or 16) at a time so the vector 
+/// units can work across the rows.
+/// </summary>
+/// <param name="inputs">the network input rows</param>
+/// <param name="outputs">the network output rows</param>
+/// <param name="numRows">the number of rows</param>
+/// <param name="laneWidth">the number of rows evaluated together (4, 8 or 16)</param>
+/// 
+void NNetFrozen::getResponses(const double* inputs, double* outputs, int numRows, int laneWidth) const
+{
+	if(mLayerSizes.empty() || numRows <= 0)
+	{
+		return;
+	}
+
+	switch(laneWidth)
+	{
+	case 4:
+		getLaneResponses<4>(inputs, outputs, numRows);
+		break;
+
+	case 16:
+		getLaneResponses<16>(inputs, outputs, numRows);
+		break;
+
+	default:
+		getLaneResponses<8>(inputs, outputs, numRows);
+		break;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the responses of the network to a batch of input rows - the
+/// inputs vector holds the rows one after another and the outputs 
+/// vector is resized to hold the corresponding output rows
+/// </summary>
+/// <param name="inputs">the network input rows</param>
+/// <param name="outputs">the network output rows</param>
+/// <param name="laneWidth">the number of rows evaluated together (4, 8 or 16)</param>
+/// 
+void NNetFrozen::getResponses(const vector<double>& inputs, vector<double>& outputs, int laneWidth) const
+{
+	if(mNumInputs > 0 && !mLayerSizes.empty())
+	{
+		int numRows = (int)inputs.size() / mNumInputs;
+
+		outputs.resize(numRows * getNumOutputs());
+
+		getResponses(inputs.data(), outputs.data(), numRows, laneWidth);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// generates a report comparing the stored weights and the responses
+/// of this network with those of the original network - 
+/// 
+/// For each layer the report gives the largest and rms differences
+/// between the stored weights and the double precision weights of the
+/// original network, along with the number of weights too large for
+/// the storage type. The responses to the sample rows (which may be 
+/// empty) are then compared in the same way.
+/// </summary>
+/// <param name="net">the original network</param>
+/// <param name="sampleInputs">the input rows to compare the responses for</param>
+/// <returns>the report text</returns>
+/// 
+string NNetFrozen::getPrecisionReport(const NeuralNet& net, const vector<double>& sampleInputs) const
+{
+	static const char* scalarNames[] = { "double", "fp16", "bf16" };
+	int nLayers = (int)mLayerSizes.size();
+	ostringstream report;
+
+	if(nLayers == 0 || net.getNumLayers() + 1 != nLayers || net.getNumInputs() != mNumInputs)
+	{
+		report << "The network could not be compared with the original network" << endl;
+
+		return report.str();
+	}
+
+	vector<double> original, stored;
+	size_t numWeights = 0;
+
+	for(int i = 0; i < nLayers; i++)
+	{
+		numWeights += (size_t)getLayerInputs(i) * mLayerSizes[i];
+	}
+
+	report << "Reduced precision network accuracy" << endl;
+	report << "Weight storage: " << getWeightBytes() << " bytes ("
+		   << numWeights * sizeof(double) << " bytes in double precision)" << endl;
+
+	for(int i = 0; i < nLayers; i++)
+	{
+		const NNetWeightedConnect& connect = net.getWeightedConnect(i);
+		int nIn = getLayerInputs(i);
+		int nOut = mLayerSizes[i];
+		double maxError = 0.0, rmsError = 0.0;
+		int numOutOfRange = 0;
+
+		if(connect.getNumInputNodes() != nIn || connect.getNumOutputNodes() != nOut)
+		{
+			report << "The network could not be compared with the original network" << endl;
+
+			return report.str();
+		}
+
+		stored.resize((size_t)nIn * nOut);
+		getLayerWeights(i, stored.data());
+
+		for(int j = 0; j < nOut; j++)
+		{
+			connect.getWeightVector(j, original);
+
+			for(int k = 0; k < nIn; k++)
+			{
+				double weight = stored[(size_t)j * nIn + k];
+
+				// a weight beyond the range of the storage type becomes infinite
+				if(fabs(weight) == HUGE_VAL)
+				{
+					numOutOfRange++;
+				}
+				else
+				{
+					double error = fabs(weight - original[k]);
+
+					maxError = max(maxError, error);
+					rmsError += error * error;
+				}
+			}
+		}
+
+		rmsError = sqrt(rmsError / ((size_t)nIn * nOut));
+
+		report << ((i < nLayers - 1) ? "Hidden layer " : "Output layer");
+		
+		if(i < nLayers - 1)
+		{
+			report << i + 1;
+		}
+
+		report << " (" << scalarNames[mLayerScalars[i]] << "): max weight error = " << maxError 
+			   << ", rms weight error = " << rmsError;
+
+		if(numOutOfRange > 0)
+		{
+			report << ", " << numOutOfRange << " weights out of range";
+		}
+
+		report << endl;
+	}
+
+	int numOutputs = getNumOutputs();
+	int numRows = (int)sampleInputs.size() / mNumInputs;
+
+	if(numRows > 0)
+	{
+		vector<double> netOutputs, outputs;
+
+		net.getResponses(sampleInputs, netOutputs);
+		getResponses(sampleInputs, outputs);
+
+		report << "Rows compared: " << numRows << endl;
+
+		for(int k = 0; k < numOutputs; k++)
+		{
+			double maxError = 0.0, rmsError = 0.0;
+
+			for(int r = 0; r < numRows; r++)
+			{
+				size_t idx = (size_t)r * numOutputs + k;
+				double error = fabs(netOutputs[idx] - outputs[idx]);
+
+				maxError = max(maxError, error);
+				rmsError += error * error;
+			}
+
+			report << "Output " << k + 1 << ": max error = " << maxError
+				   << ", rms error = " << sqrt(rmsError / numRows) << endl;
+		}
+	}
+
+	return report.str();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Private Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the responses to a batch of input rows L rows at a time - 
+/// 
+/// The rows are copied into lane order (all the lanes for the first 
+/// input followed by all the lanes for the second input and so on)
+/// and every layer is then applied with the lanes as the innermost 
+/// loop. A final partial block is padded with zeros.
+/// </summary>
+/// <param name="inputs">the network input rows</param>
+/// <param name="outputs">the network output rows</param>
+/// <param name="numRows">the number of rows</param>
+/// 
+template<int L>
+void NNetFrozen::getLaneResponses(const double* inputs, double* outputs, int numRows) const
+{
+	int nLayers = (int)mLayerSizes.size();
+	int nOutputs = getNumOutputs();
+	int layerSize = max(mMaxLayerSize, mNumInputs) * L;
+
+	// three lane ordered buffers - the inputs and two for the layer values
+	vector<double> scratch(3 * layerSize);
+	double* laneInputs = scratch.data();
+
+	for(int r = 0; r < numRows; r += L)
+	{
+		int nLanes = min(L, numRows - r);
+		const double* rowInputs = inputs + (size_t)r * mNumInputs;
+
+		// copy the rows into lane order
+		for(int k = 0; k < mNumInputs; k++)
+		{
+			for(int l = 0; l < L; l++)
+			{
+				laneInputs[k * L + l] = (l < nLanes) ? rowInputs[l * mNumInputs + k] : 0.0;
+			}
+		}
+
+		const double* layerInputs = laneInputs;
+		int nIn = mNumInputs;
+
+		for(int i = 0; i < nLayers; i++)
+		{
+			int nOut = mLayerSizes[i];
+			double* layerOutputs = scratch.data() + (1 + i % 2) * layerSize;
+
+			// apply the weighted connections to every lane
+			switch(mLayerScalars[i])
+			{
+			case kFloat16:
+				applyLaneWeights<L, NNetFloat16Reader>(getHalfWeightBase() + mLayerOffsets[i], 
+													   layerInputs, layerOutputs, nIn, nOut);
+				break;
+
+			case kBFloat16:
+				applyLaneWeights<L, NNetBFloat16Reader>(getHalfWeightBase() + mLayerOffsets[i], 
+														layerInputs, layerOutputs, nIn, nOut);
+				break;
+
+			default:
+				applyLaneWeights<L, NNetDoubleReader>(getWeightBase() + mLayerOffsets[i], 
+													  layerInputs, layerOutputs, nIn, nOut);
+				break;
+			}
+
+			// activate the layer units for every lane in one pass
+			mLayerKernels[i](layerOutputs, layerOutputs, nOut * L, mLayerSlope[i], mLayerAmplify[i]);
+
+			layerInputs = layerOutputs;
+			nIn = nOut;
+		}
+
+		// copy the valid lanes back into row order
+		double* rowOutputs = outputs + (size_t)r * nOutputs;
+
+		for(int l = 0; l < nLanes; l++)
+		{
+			for(int j = 0; j < nOutputs; j++)
+			{
+				rowOutputs[l * nOutputs + j] = layerInputs[j * L + l];
+			}
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the start of the weights - the packed buffer or, when the 
+/// weights are used in place, the start of the mapped file
+/// </summary>
+/// <returns>the start of the weights</returns>
+/// 
+const double* NNetFrozen::getWeightBase() const
+{
+	if(mMapping)
+	{
+		return reinterpret_cast<const double*>(mMapping->getData());
+	}
+
+	return mWeights.data();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the start of the 16 bit weights - the packed buffer or, when
+/// the weights are used in place, the start of the mapped file
+/// </summary>
+/// <returns>the start of the 16 bit weights</returns>
+/// 
+const unsigned short* NNetFrozen::getHalfWeightBase() const
+{
+	if(mMapping)
+	{
+		return reinterpret_cast<const unsigned short*>(mMapping->getData());
+	}
+
+	return mHalfWeights.data();
+}
+
+/////////////////////////////////////////////////////////////////////
@@ -0,0 +1,177 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NNetFrozen class
+//
+// Author: Jason Jenkins
+//
+// This class is a compact, read only representation of a trained
+// feed forward neural network that is optimised for calculating 
+// responses.
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <algorithm>
+
+/////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetUnit.h"
+#include "NNetWeightedConnect.h"
+#include "NNetHalf.h"
+
+/////////////////////////////////////////////////////////////////////
+
+class NNetMappedFile;
+class NeuralNet;
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class is a compact, read only representation of a trained
+/// feed forward neural network that is optimised for calculating 
+/// responses.
+/// </summary>
+/// 
+class NNetFrozen
+{
+public:
+	NNetFrozen();
+	virtual ~NNetFrozen();
+
+	// clears a NNetFrozen object ready for re-use
+	void clearFrozenNet();
+
+	// sets the number of input units
+	void setNumInputs(int numInputs);
+
+	// appends a layer to the network
+	int addLayer(const NNetWeightedConnect& connect, ActiveT unitType, 
+				 double slope, double amplify, ScalarT scalarType = kFloat64);
+
+	// builds the network from a binary network file using the weights in place from a mapping of the file
+	int openMapped(const string& fname, bool verifyChecksum = true);
+
+	/// <summary>
+	/// </summary>
+	/// <returns>true if the weights are used in place from a mapped file</returns>
+	bool isMapped() const { return (bool)mMapping; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of input units</returns>
+	int getNumInputs() const { return mNumInputs; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of output units</returns>
+	int getNumOutputs() const { return mLayerSizes.empty() ? 0 : mLayerSizes.back(); }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of hidden layers</returns>
+	int getNumLayers() const { return max((int)mLayerSizes.size() - 1, 0); }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of scratch values needed by getResponse</returns>
+	int getScratchSize() const { return 2 * mMaxLayerSize; }
+
+	// gets the number of units in the specified layer
+	int getLayerSize(int layer) const;
+
+	// gets the number of inputs to the specified layer
+	int getLayerInputs(int layer) const;
+
+	// gets the packed weights of the connections into the specified layer
+	const double* getLayerWeights(int layer) const;
+
+	// copies the weights of the connections into the specified layer as doubles
+	int getLayerWeights(int layer, double* weights) const;
+
+	// gets the type the weights of the specified layer are stored as
+	ScalarT getLayerScalarType(int layer) const;
+
+	// gets the number of bytes used by the weights
+	size_t getWeightBytes() const;
+
+	// gets the activation function details of the specified layer
+	void getLayerDetails(int layer, ActiveT& unitType, double& slope, double& amplify) const;
+
+	// gets the response of the network to the given input
+	void getResponse(const double* inputs, double* outputs, double* scratch) const;
+	void getResponse(const vector<double>& inputs, vector<double>& outputs, 
+					 vector<double>& scratch) const;
+
+	// gets the responses of the network to a batch of input rows
+	void getResponses(const double* inputs, double* outputs, int numRows, int laneWidth = 8) const;
+	void getResponses(const vector<double>& inputs, vector<double>& outputs, int laneWidth = 8) const;
+
+	// generates a report comparing the stored weights and the responses with those of the original network
+	string getPrecisionReport(const NeuralNet& net, const vector<double>& sampleInputs) const;
+
+private:
+	// gets the responses to a batch of input rows a fixed number of rows at a time
+	template<int L>
+	void getLaneResponses(const double* inputs, double* outputs, int numRows) const;
+
+	// gets the start of the weights - the layer offsets are relative to this
+	const double* getWeightBase() const;
+
+	// gets the start of the 16 bit weights - the layer offsets are relative to this
+	const unsigned short* getHalfWeightBase() const;
+
+private:
+	/// <summary>the number of input units</summary>
+	int mNumInputs;
+
+	/// <summary>the number of units in the largest layer</summary>
+	int mMaxLayerSize;
+
+	/// <summary>
+	/// the weights of every layer packed into a single buffer - each layer 
+	/// is stored row by row with one row of input weights for each unit
+	/// </summary>
+	vector<double> mWeights;
+
+	/// <summary>the weights of the layers stored as 16 bit values packed in the same way</summary>
+	vector<unsigned short> mHalfWeights;
+
+	/// <summary>the offset of each layer's weights within its packed buffer</summary>
+	vector<int> mLayerOffsets;
+
+	/// <summary>the type each layer's weights are stored as</summary>
+	vector<ScalarT> mLayerScalars;
+
+	/// <summary>
+	/// the mapped file holding the weights when they are used in place
+	/// (shared by every copy of the network) - the layer offsets are 
+	/// then relative to the start of the file
+	/// </summary>
+	shared_ptr<NNetMappedFile> mMapping;
+
+	/// <summary>the number of units in each layer (the last is the output layer)</summary>
+	vector<int> mLayerSizes;
+
+	/// <summary>the activation function type of each layer</summary>
+	vector<ActiveT> mLayerTypes;
+
+	/// <summary>the resolved activation kernel of each layer</summary>
+	vector<ActivationFn> mLayerKernels;
+
+	/// <summary>the activation function slope value of each layer</summary>
+	vector<double> mLayerSlope;
+
+	/// <summary>the activation function amplify value of each layer</summary>
+	vector<double> mLayerAmplify;
+};
+
+/////////////////////////////////////////////////////////////////////
@@ -0,0 +1,246 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NNetHalf class
+//
+// Author: Jason Jenkins
+//
+// This class converts weights to and from the 16 bit floating point
+// formats used to store compact networks.
+//
+// Two 16 bit formats are supported: IEEE half precision (fp16), which
+// keeps 11 significant bits but can only hold values up to 65504, and
+// bfloat16 (bf16), which keeps the range of a float but only 8
+// significant bits. The values are held as their raw 16 bits. Weights
+// are rounded to the nearest representable value (ties to even) when
+// they are stored and are widened to float as they are used, so the 
+// layer sums are still accumulated in double precision:
+/*
+		unsigned short stored = NNetHalf::toFloat16(weight);
+
+		value += NNetHalf::fromFloat16(stored) * input;
+*/
+// The conversions are written with integer operations only so they
+// do not depend on any particular instruction set. A double is first
+// narrowed to a float using round to odd, which keeps a record of any
+// discarded bits, so the final rounding to 16 bits gives the same 
+// result as rounding the double directly.
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+
+/////////////////////////////////////////////////////////////////////
+/// The available weight storage types as an enumerated type
+
+typedef enum { kFloat64, kFloat16, kBFloat16 } ScalarT;
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class converts weights to and from the 16 bit floating point
+/// formats used to store compact networks.
+/// </summary>
+/// 
+class NNetHalf
+{
+public:
+	/// <summary>
+	/// converts a value to half precision - values beyond the fp16 range
+	/// become infinite
+	/// </summary>
+	/// <param name="value">the value</param>
+	/// <returns>the bits of the nearest half precision value</returns>
+	static unsigned short toFloat16(double value)
+	{
+		const unsigned int infinity = 255u << 23;
+		const unsigned int halfMax = (127u + 16u) << 23;
+		const unsigned int denormMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+		unsigned int bits = getRoundToOddBits(value);
+		unsigned int sign = bits & 0x80000000u;
+		unsigned int result;
+
+		bits ^= sign;
+
+		if(bits >= halfMax)
+		{
+			// infinity or NaN (NaN stays a quiet NaN)
+			result = (bits > infinity) ? 0x7e00 : 0x7c00;
+		}
+		else if(bits < (113u << 23))
+		{
+			// a subnormal half or zero - let the float addition do the rounding
+			float denorm = getFloat(bits) + getFloat(denormMagic);
+
+			result = getBits(denorm) - denormMagic;
+		}
+		else
+		{
+			// a normal half - rebias the exponent and round the mantissa to nearest even
+			unsigned int mantOdd = (bits >> 13) & 1;
+
+			bits += ((unsigned int)(15 - 127) << 23) + 0xfff + mantOdd;
+			result = bits >> 13;
+		}
+
+		return (unsigned short)(result | (sign >> 16));
+	}
+
+	/// <summary>
+	/// converts a value to bfloat16
+	/// </summary>
+	/// <param name="value">the value</param>
+	/// <returns>the bits of the nearest bfloat16 value</returns>
+	static unsigned short toBFloat16(double value)
+	{
+		unsigned int bits = getRoundToOddBits(value);
+
+		if((bits & 0x7fffffffu) > 0x7f800000u)
+		{
+			// keep NaN a quiet NaN
+			return (unsigned short)((bits >> 16) | 0x40);
+		}
+
+		// round the discarded bits to nearest even
+		bits += 0x7fff + ((bits >> 16) & 1);
+
+		return (unsigned short)(bits >> 16);
+	}
+
+	/// <summary>
+	/// widens a half precision value to a float
+	/// </summary>
+	/// <param name="value">the bits of the half precision value</param>
+	/// <returns>the value as a float</returns>
+	static float fromFloat16(unsigned short value)
+	{
+		const unsigned int shiftedExp = 0x7c00u << 13;
+		unsigned int bits = (value & 0x7fffu) << 13;
+		unsigned int exp = bits & shiftedExp;
+		float result;
+
+		// rebias the exponent
+		bits += (127u - 15u) << 23;
+
+		if(exp == shiftedExp)
+		{
+			// infinity or NaN
+			bits += (128u - 16u) << 23;
+			result = getFloat(bits);
+		}
+		else if(exp == 0)
+		{
+			// zero or a subnormal half - renormalise
+			bits += 1u << 23;
+			result = getFloat(bits) - getFloat(113u << 23);
+		}
+		else
+		{
+			result = getFloat(bits);
+		}
+
+		return getFloat(getBits(result) | ((unsigned int)(value & 0x8000u) << 16));
+	}
+
+	/// <summary>
+	/// widens a bfloat16 value to a float
+	/// </summary>
+	/// <param name="value">the bits of the bfloat16 value</param>
+	/// <returns>the value as a float</returns>
+	static float fromBFloat16(unsigned short value)
+	{
+		return getFloat((unsigned int)value << 16);
+	}
+
+	/// <summary>
+	/// gets the value a double becomes when it is stored as the given type
+	/// </summary>
+	/// <param name="value">the value</param>
+	/// <param name="scalarType">the storage type</param>
+	/// <returns>the stored value</returns>
+	static double getStoredValue(double value, ScalarT scalarType)
+	{
+		switch(scalarType)
+		{
+		case kFloat16:
+			return fromFloat16(toFloat16(value));
+
+		case kBFloat16:
+			return fromBFloat16(toBFloat16(value));
+
+		default:
+			return value;
+		}
+	}
+
+	/// <summary>
+	/// </summary>
+	/// <param name="scalarType">the storage type</param>
+	/// <returns>the size of a value of the given type in bytes</returns>
+	static int getScalarSize(ScalarT scalarType) { return (scalarType == kFloat64) ? 8 : 2; }
+
+private:
+	/// <summary>
+	/// narrows a double to a float using round to odd - 
+	/// 
+	/// An inexact result is truncated towards zero and its lowest bit 
+	/// set. The float keeps at least 13 more bits than either 16 bit
+	/// format, so rounding it to nearest even a second time gives the
+	/// correctly rounded 16 bit value. Rounding to nearest twice can
+	/// be wrong when the first rounding lands exactly half way between
+	/// two 16 bit values.
+	/// </summary>
+	/// <param name="value">the value</param>
+	/// <returns>the bits of the float value</returns>
+	static unsigned int getRoundToOddBits(double value)
+	{
+		float narrowed = (float)value;
+		double widened = narrowed;
+		unsigned int bits = getBits(narrowed);
+
+		// NaN compares unequal to itself and is left as it is
+		if(widened != value && value == value)
+		{
+			// step back towards zero if the float was rounded away from zero
+			// (this also turns an overflow to infinity into the largest float)
+			if((value > 0) ? (widened > value) : (widened < value))
+			{
+				bits--;
+			}
+
+			bits |= 1;
+		}
+
+		return bits;
+	}
+
+	/// <summary>
+	/// </summary>
+	/// <param name="value">a float value</param>
+	/// <returns>the bits of the value</returns>
+	static unsigned int getBits(float value)
+	{
+		unsigned int bits;
+
+		memcpy(&bits, &value, sizeof(bits));
+
+		return bits;
+	}
+
+	/// <summary>
+	/// </summary>
+	/// <param name="bits">the bits of a float value</param>
+	/// <returns>the float value</returns>
+	static float getFloat(unsigned int bits)
+	{
+		float value;
+
+		memcpy(&value, &bits, sizeof(value));
+
+		return value;
+	}
+};
+
+/////////////////////////////////////////////////////////////////////
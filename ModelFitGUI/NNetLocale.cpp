@@ -0,0 +1,167 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Implements the NNetLocale class
+//
+// Author: Jason Jenkins
+//
+// This class converts numbers to and from text in the same form 
+// whatever locale the process is using.
+//
+// The standard conversions follow the LC_NUMERIC category of the 
+// current locale, so once a process calls setlocale with a locale
+// that uses a decimal comma a network file holding "0.5" is read as 
+// 0 and the rest of the line is rejected. The network files are 
+// always written with a decimal point, so these conversions use the
+// "C" locale whatever locale is set:
+/*
+		char buffer[32];
+		char* end;
+
+		NNetLocale::formatText(buffer, sizeof(buffer), "%.17g", 0.5);
+
+		double value = NNetLocale::toDouble(buffer, &end);
+*/
+// On Windows the "_l" forms of the conversions are given a "C" locale
+// created once with _create_locale. Elsewhere the calling thread is
+// switched to a "C" locale with uselocale for the conversion, which
+// leaves every other thread alone.
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetLocale.h"
+
+/////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <locale.h>
+
+#if defined(__APPLE__)
+#include <xlocale.h>
+#endif
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef _WIN32
+typedef _locale_t CLocaleT;
+#else
+typedef locale_t CLocaleT;
+#endif
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the "C" locale - it is created the first time it is needed
+/// and kept for the life of the process
+/// </summary>
+/// <returns>the "C" locale</returns>
+/// 
+static CLocaleT getCLocale()
+{
+#ifdef _WIN32
+	static const CLocaleT cLocale = _create_locale(LC_NUMERIC, "C");
+#else
+	static const CLocaleT cLocale = newlocale(LC_NUMERIC_MASK, "C", (locale_t)0);
+#endif
+
+	return cLocale;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Public Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// converts the start of a string to a double using the "C" locale -
+/// as strtod but always with a decimal point
+/// </summary>
+/// <param name="text">the string - any leading white space is skipped</param>
+/// <param name="end">receives the position after the value (text if there is no value)</param>
+/// <returns>the value or 0 if there is no value</returns>
+/// 
+double NNetLocale::toDouble(const char* text, char** end)
+{
+#ifdef _WIN32
+	return _strtod_l(text, end, getCLocale());
+#else
+	locale_t previous = uselocale(getCLocale());
+	double value = strtod(text, end);
+
+	uselocale(previous);
+
+	return value;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// formats values into a buffer using the "C" locale - as snprintf 
+/// but always with a decimal point
+/// </summary>
+/// <param name="buffer">the buffer - always terminated</param>
+/// <param name="size">the size of the buffer</param>
+/// <param name="format">the printf style format</param>
+/// <returns>the number of characters written (not counting the terminator)</returns>
+/// 
+int NNetLocale::formatText(char* buffer, size_t size, const char* format, ...)
+{
+	va_list args;
+
+	va_start(args, format);
+	int used = formatTextList(buffer, size, format, args);
+	va_end(args);
+
+	return used;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// formats a list of values into a buffer using the "C" locale - as 
+/// vsnprintf but always with a decimal point. Text that does not fit
+/// is cut short rather than counted.
+/// </summary>
+/// <param name="buffer">the buffer - always terminated</param>
+/// <param name="size">the size of the buffer</param>
+/// <param name="format">the printf style format</param>
+/// <param name="args">the values</param>
+/// <returns>the number of characters written (not counting the terminator)</returns>
+/// 
+int NNetLocale::formatTextList(char* buffer, size_t size, const char* format, va_list args)
+{
+	if(size == 0)
+	{
+		return 0;
+	}
+
+#ifdef _WIN32
+	int used = _vsnprintf_s_l(buffer, size, _TRUNCATE, format, getCLocale(), args);
+
+	// the text was cut short - the buffer holds as much as fits
+	if(used < 0)
+	{
+		used = (int)strlen(buffer);
+	}
+#else
+	locale_t previous = uselocale(getCLocale());
+	int used = vsnprintf(buffer, size, format, args);
+
+	uselocale(previous);
+
+	if(used < 0)
+	{
+		// the values could not be formatted
+		used = 0;
+		buffer[0] = '\0';
+	}
+	else if((size_t)used >= size)
+	{
+		// the text was cut short - the buffer holds as much as fits
+		used = (int)size - 1;
+	}
+#endif
+
+	return used;
+}
+
+/////////////////////////////////////////////////////////////////////
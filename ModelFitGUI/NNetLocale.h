@@ -0,0 +1,38 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NNetLocale class
+//
+// Author: Jason Jenkins
+//
+// This class converts numbers to and from text in the same form 
+// whatever locale the process is using.
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <stdarg.h>
+#include <stddef.h>
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class converts numbers to and from text in the same form 
+/// whatever locale the process is using.
+/// </summary>
+/// 
+class NNetLocale
+{
+public:
+	// converts the start of a string to a double using the "C" locale
+	static double toDouble(const char* text, char** end);
+
+	// formats values into a buffer using the "C" locale
+	static int formatText(char* buffer, size_t size, const char* format, ...);
+
+	// formats a list of values into a buffer using the "C" locale
+	static int formatTextList(char* buffer, size_t size, const char* format, va_list args);
+};
+
+/////////////////////////////////////////////////////////////////////
@@ -0,0 +1,155 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Implements the NNetMappedFile class
+//
+// Author: Jason Jenkins
+//
+// This class maps a file into memory for reading so its contents can
+// be used in place and shared between processes.
+//
+// The file is mapped read only, so its pages are loaded on demand
+// from the operating system's page cache and are shared by every
+// process that maps the same file - opening a file takes the same
+// short time however large it is and no process holds its own copy.
+// The mapping is released when the object is destroyed.
+/*
+		NNetMappedFile mapping;
+
+		if(mapping.openFile("network.bin") == 0)
+		{
+			const char* data = mapping.getData();
+			size_t length = mapping.getLength();
+		}
+*/
+// Windows file mappings are used on Windows and mmap elsewhere.
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetMappedFile.h"
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// default constructor
+/// </summary>
+/// 
+NNetMappedFile::NNetMappedFile()
+{
+	mData = NULL;
+	mLength = 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// destructor
+/// </summary>
+/// 
+NNetMappedFile::~NNetMappedFile()
+{
+	closeFile();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Public Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// maps a file into memory for reading - any file already mapped by
+/// this object is unmapped first
+/// </summary>
+/// <param name="fname">the file to map</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NNetMappedFile::openFile(const string& fname)
+{
+	closeFile();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(fname.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+							  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+	if(file == INVALID_HANDLE_VALUE)
+	{
+		return -1;
+	}
+
+	LARGE_INTEGER size;
+	HANDLE mapping = NULL;
+
+	if(GetFileSizeEx(file, &size) && size.QuadPart > 0)
+	{
+		mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	}
+
+	if(mapping != NULL)
+	{
+		mData = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		mLength = (mData != NULL) ? (size_t)size.QuadPart : 0;
+
+		// the view keeps the mapping open
+		CloseHandle(mapping);
+	}
+
+	CloseHandle(file);
+#else
+	int file = open(fname.c_str(), O_RDONLY);
+
+	if(file < 0)
+	{
+		return -1;
+	}
+
+	struct stat info;
+
+	if(fstat(file, &info) == 0 && info.st_size > 0)
+	{
+		void* data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, file, 0);
+
+		if(data != MAP_FAILED)
+		{
+			mData = static_cast<const char*>(data);
+			mLength = (size_t)info.st_size;
+		}
+	}
+
+	// the mapping keeps the file open
+	close(file);
+#endif
+
+	return (mData != NULL) ? 0 : -1;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// unmaps the file - the contents returned by getData can no longer
+/// be used
+/// </summary>
+/// 
+void NNetMappedFile::closeFile()
+{
+	if(mData != NULL)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(mData);
+#else
+		munmap(const_cast<char*>(mData), mLength);
+#endif
+	}
+
+	mData = NULL;
+	mLength = 0;
+}
+
+/////////////////////////////////////////////////////////////////////
@@ -0,0 +1,64 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NNetMappedFile class
+//
+// Author: Jason Jenkins
+//
+// This class maps a file into memory for reading so its contents can
+// be used in place and shared between processes.
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <stddef.h>
+
+/////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class maps a file into memory for reading so its contents can
+/// be used in place and shared between processes.
+/// </summary>
+/// 
+class NNetMappedFile
+{
+public:
+	NNetMappedFile();
+	virtual ~NNetMappedFile();
+
+	// maps a file into memory for reading
+	int openFile(const string& fname);
+
+	// unmaps the file
+	void closeFile();
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the contents of the file or NULL if no file is mapped</returns>
+	const char* getData() const { return mData; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the length of the file</returns>
+	size_t getLength() const { return mLength; }
+
+private:
+	// a mapping can not be copied
+	NNetMappedFile(const NNetMappedFile&) = delete;
+	NNetMappedFile& operator=(const NNetMappedFile&) = delete;
+
+private:
+	/// <summary>the start of the mapped file</summary>
+	const char* mData;
+
+	/// <summary>the length of the mapped file</summary>
+	size_t mLength;
+};
+
+/////////////////////////////////////////////////////////////////////
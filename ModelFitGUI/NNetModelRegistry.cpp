@@ -0,0 +1,448 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Implements the NNetModelRegistry class
+//
+// Author: Jason Jenkins
+//
+// This class holds a set of named, trained neural networks for a long
+// running process and reloads each one when its file is replaced.
+//
+// Each model is loaded from a file written by NeuralNet::writeToFile or
+// NeuralNet::writeToBinaryFile and held in its frozen form. A background
+// thread checks the files every few seconds and when a file changes
+// the new version is loaded in the background and then swapped in with
+// a single pointer assignment. Callers hold a shared pointer to the
+// version they were given, so responses already being calculated
+// finish on the old weights, which are released once the last caller
+// lets go of them, and new calls get the new version straight away:
+/*
+		NNetModelRegistry registry;
+
+		registry.addModel("wage", "Wage_TrainedNetwork.net");
+
+		...
+
+		shared_ptr<const NNetFrozen> model = registry.getModel("wage");
+
+		model->getResponse(inputs, outputs, scratch);
+*/
+// A changed file is only loaded once it has been seen unchanged by two
+// checks in a row, as a text file cut off part way through its last
+// weight would still load. A file that can not be loaded leaves the 
+// current version in place and is tried again when it next changes. Files are read into memory rather than mapped
+// so a model file can safely be overwritten while it is in use.
+//
+// This file uses the standard thread library so it is compiled as
+// native code.
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetModelRegistry.h"
+#include "NeuralNet.h"
+
+/////////////////////////////////////////////////////////////////////
+
+#include <map>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// the last modification time, size and identity of a file
+/// </summary>
+/// 
+struct NNetFileStamp
+{
+	/// <summary>the last modification time (in 100ns units on Windows, otherwise nanoseconds)</summary>
+	long long modified = -1;
+
+	/// <summary>the size of the file in bytes</summary>
+	long long size = -1;
+
+	/// <summary>the file serial number - changes when the file is replaced by a rename (0 on Windows)</summary>
+	long long id = -1;
+
+	bool operator==(const NNetFileStamp& other) const 
+	{ 
+		return modified == other.modified && size == other.size && id == other.id; 
+	}
+
+	bool operator!=(const NNetFileStamp& other) const { return !(*this == other); }
+};
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// a model held by the registry
+/// </summary>
+/// 
+struct NNetRegistryEntry
+{
+	/// <summary>the model file</summary>
+	string fileName;
+
+	/// <summary>the current version of the model</summary>
+	shared_ptr<const NNetFrozen> model;
+
+	/// <summary>the stamp of the file the current version was loaded from</summary>
+	NNetFileStamp loaded;
+
+	/// <summary>the stamp of the file the last time it could not be loaded</summary>
+	NNetFileStamp failed;
+
+	/// <summary>the stamp of the file at the last check - a changed file is loaded once it stops changing</summary>
+	NNetFileStamp seen;
+
+	/// <summary>the number of times the model has been loaded</summary>
+	int version = 0;
+};
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// the models and watcher thread state of a registry
+/// </summary>
+/// 
+struct NNetRegistryState
+{
+	/// <summary>guards the members below</summary>
+	mutex lock;
+
+	/// <summary>wakes the watcher thread early</summary>
+	condition_variable signal;
+
+	/// <summary>the models by name</summary>
+	map<string, NNetRegistryEntry> entries;
+
+	/// <summary>the number of seconds between checks of the model files</summary>
+	double pollInterval = 2.0;
+
+	/// <summary>true when the watcher thread is to finish</summary>
+	bool stopping = false;
+
+	/// <summary>only one check of the model files runs at a time</summary>
+	mutex checkLock;
+
+	/// <summary>the watcher thread</summary>
+	thread watcher;
+};
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the last modification time, size and identity of a file - 
+/// 
+/// The modification time is read at the full resolution the system 
+/// keeps (whole seconds would miss a file replaced by another of the
+/// same size within the same second). A model written to a temporary
+/// file and renamed over the old one also gets a new serial number.
+/// </summary>
+/// <param name="fname">the file</param>
+/// <param name="stamp">receives the modification time, size and identity</param>
+/// <returns>true if successful or false if the file can not be found</returns>
+/// 
+static bool getFileStamp(const string& fname, NNetFileStamp& stamp)
+{
+#ifdef _WIN32
+	WIN32_FILE_ATTRIBUTE_DATA info;
+
+	if(!GetFileAttributesExA(fname.c_str(), GetFileExInfoStandard, &info))
+	{
+		return false;
+	}
+
+	stamp.modified = ((long long)info.ftLastWriteTime.dwHighDateTime << 32) | info.ftLastWriteTime.dwLowDateTime;
+	stamp.size = ((long long)info.nFileSizeHigh << 32) | info.nFileSizeLow;
+	stamp.id = 0;
+#else
+	struct stat info;
+
+	if(stat(fname.c_str(), &info) != 0)
+	{
+		return false;
+	}
+
+#ifdef __APPLE__
+	stamp.modified = (long long)info.st_mtimespec.tv_sec * 1000000000 + info.st_mtimespec.tv_nsec;
+#else
+	stamp.modified = (long long)info.st_mtim.tv_sec * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+	stamp.size = (long long)info.st_size;
+	stamp.id = (long long)info.st_ino;
+#endif
+
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// loads a model from a text or binary network file
+/// </summary>
+/// <param name="fname">the model file</param>
+/// <returns>the model or NULL if the file can not be loaded</returns>
+/// 
+static shared_ptr<const NNetFrozen> loadModel(const string& fname)
+{
+	NeuralNet net(fname);
+
+	if(net.getNumLayers() < 1)
+	{
+		return shared_ptr<const NNetFrozen>();
+	}
+
+	return make_shared<const NNetFrozen>(net.freeze());
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// checks the model files for new versions at the poll interval until
+/// the registry is destroyed
+/// </summary>
+/// <param name="registry">the registry</param>
+/// <param name="state">the registry state</param>
+/// 
+static void watchModels(NNetModelRegistry* registry, NNetRegistryState* state)
+{
+	unique_lock<mutex> guard(state->lock);
+
+	while(!state->stopping)
+	{
+		chrono::duration<double> interval(state->pollInterval);
+
+		state->signal.wait_for(guard, interval);
+
+		if(!state->stopping)
+		{
+			guard.unlock();
+			registry->checkForUpdates();
+			guard.lock();
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// default constructor - starts the watcher thread
+/// </summary>
+/// 
+NNetModelRegistry::NNetModelRegistry()
+	: mState(new NNetRegistryState())
+{
+	mState->watcher = thread(watchModels, this, mState.get());
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// destructor - stops the watcher thread
+/// </summary>
+/// 
+NNetModelRegistry::~NNetModelRegistry()
+{
+	{
+		lock_guard<mutex> guard(mState->lock);
+		mState->stopping = true;
+	}
+
+	mState->signal.notify_all();
+	mState->watcher.join();
+}
+
+/////////////////////////////////////////////////////////////////////
+// Public Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// loads a model from a file and watches the file for new versions -
+/// any model already held under the same name is replaced
+/// </summary>
+/// <param name="name">the name of the model</param>
+/// <param name="fname">the model file</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NNetModelRegistry::addModel(const string& name, const string& fname)
+{
+	NNetRegistryEntry entry;
+
+	entry.fileName = fname;
+
+	// the stamp is taken first so a change during loading is picked up later
+	if(!getFileStamp(fname, entry.loaded))
+	{
+		return -1;
+	}
+
+	entry.model = loadModel(fname);
+
+	if(!entry.model)
+	{
+		return -1;
+	}
+
+	entry.version = 1;
+
+	lock_guard<mutex> guard(mState->lock);
+
+	mState->entries[name] = entry;
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// stops watching a model and removes it from the registry - callers
+/// still holding the model can carry on using it
+/// </summary>
+/// <param name="name">the name of the model</param>
+/// 
+void NNetModelRegistry::removeModel(const string& name)
+{
+	lock_guard<mutex> guard(mState->lock);
+
+	mState->entries.erase(name);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the current version of a model - the version returned stays
+/// valid for as long as it is held, whatever happens to the registry
+/// </summary>
+/// <param name="name">the name of the model</param>
+/// <returns>the model or NULL if there is no model with the given name</returns>
+/// 
+shared_ptr<const NNetFrozen> NNetModelRegistry::getModel(const string& name) const
+{
+	lock_guard<mutex> guard(mState->lock);
+
+	auto iter = mState->entries.find(name);
+
+	if(iter == mState->entries.end())
+	{
+		return shared_ptr<const NNetFrozen>();
+	}
+
+	return iter->second.model;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the number of times a model has been loaded
+/// </summary>
+/// <param name="name">the name of the model</param>
+/// <returns>the number of times the model has been loaded or 0 if there is no such model</returns>
+/// 
+int NNetModelRegistry::getVersion(const string& name) const
+{
+	lock_guard<mutex> guard(mState->lock);
+
+	auto iter = mState->entries.find(name);
+
+	return (iter != mState->entries.end()) ? iter->second.version : 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets how often the model files are checked for new versions
+/// </summary>
+/// <param name="numSeconds">the number of seconds between checks</param>
+/// 
+void NNetModelRegistry::setPollInterval(double numSeconds)
+{
+	{
+		lock_guard<mutex> guard(mState->lock);
+		mState->pollInterval = max(numSeconds, 0.01);
+	}
+
+	mState->signal.notify_all();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// reloads every model whose file has changed - this is called by the
+/// watcher thread but can also be called directly. A changed file is 
+/// loaded by the first check that finds it unchanged since the check 
+/// before. The files are loaded without holding the lock so getModel 
+/// is never held up.
+/// </summary>
+/// <returns>the number of models reloaded</returns>
+/// 
+int NNetModelRegistry::checkForUpdates()
+{
+	lock_guard<mutex> checkGuard(mState->checkLock);
+	vector<pair<string, NNetRegistryEntry> > entries;
+	int numReloaded = 0;
+
+	{
+		lock_guard<mutex> guard(mState->lock);
+		entries.assign(mState->entries.begin(), mState->entries.end());
+	}
+
+	for(size_t i = 0; i < entries.size(); i++)
+	{
+		NNetRegistryEntry& entry = entries[i].second;
+		NNetFileStamp stamp;
+
+		// skip files that have not changed or that could not be loaded as they are
+		if(!getFileStamp(entry.fileName, stamp) || stamp == entry.loaded || stamp == entry.failed)
+		{
+			continue;
+		}
+
+		// skip files that have changed since the last check as they may still be being written
+		if(stamp != entry.seen)
+		{
+			lock_guard<mutex> guard(mState->lock);
+			auto iter = mState->entries.find(entries[i].first);
+
+			if(iter != mState->entries.end() && iter->second.loaded == entry.loaded)
+			{
+				iter->second.seen = stamp;
+			}
+
+			continue;
+		}
+
+		shared_ptr<const NNetFrozen> model = loadModel(entry.fileName);
+		NNetFileStamp loadedStamp;
+
+		// a file that changed while it was loading is tried again at the next check
+		if(!getFileStamp(entry.fileName, loadedStamp) || loadedStamp != stamp)
+		{
+			continue;
+		}
+
+		lock_guard<mutex> guard(mState->lock);
+
+		// the model may have been removed or replaced while it was loading
+		auto iter = mState->entries.find(entries[i].first);
+
+		if(iter == mState->entries.end() || iter->second.loaded != entry.loaded)
+		{
+			continue;
+		}
+
+		if(model)
+		{
+			// the old version is released (if no one else holds it) once the lock is released
+			iter->second.model.swap(model);
+			iter->second.loaded = stamp;
+			iter->second.version++;
+			numReloaded++;
+		}
+		else
+		{
+			iter->second.failed = stamp;
+		}
+	}
+
+	return numReloaded;
+}
+
+/////////////////////////////////////////////////////////////////////
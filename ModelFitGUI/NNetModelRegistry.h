@@ -0,0 +1,72 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NNetModelRegistry class
+//
+// Author: Jason Jenkins
+//
+// This class holds a set of named, trained neural networks for a long
+// running process and reloads each one when its file is replaced.
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <memory>
+
+/////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetFrozen.h"
+
+/////////////////////////////////////////////////////////////////////
+
+// the models and watcher thread state (defined in NNetModelRegistry.cpp)
+struct NNetRegistryState;
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class holds a set of named, trained neural networks for a long
+/// running process and reloads each one when its file is replaced.
+/// </summary>
+/// 
+class NNetModelRegistry
+{
+public:
+	NNetModelRegistry();
+	virtual ~NNetModelRegistry();
+
+	// loads a model from a file and watches the file for new versions
+	int addModel(const string& name, const string& fname);
+
+	// stops watching a model and removes it from the registry
+	void removeModel(const string& name);
+
+	// gets the current version of a model
+	shared_ptr<const NNetFrozen> getModel(const string& name) const;
+
+	// gets the number of times a model has been loaded
+	int getVersion(const string& name) const;
+
+	// sets how often the model files are checked for new versions
+	void setPollInterval(double numSeconds);
+
+	// reloads every model whose file has changed
+	int checkForUpdates();
+
+private:
+	// a registry can not be copied
+	NNetModelRegistry(const NNetModelRegistry&) = delete;
+	NNetModelRegistry& operator=(const NNetModelRegistry&) = delete;
+
+private:
+	/// <summary>the models and watcher thread state</summary>
+	unique_ptr<NNetRegistryState> mState;
+};
+
+/////////////////////////////////////////////////////////////////////
@@ -0,0 +1,389 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Implements the NNetOptimiser class
+//
+// Author: Jason Jenkins
+//
+// This class produces an equivalent but cheaper copy of a trained 
+// neural network (NeuralNet).
+//
+// Every unit in a network multiplies its input by the slope value of
+// its activation function and its activation by the amplify value 
+// (see NNetUnit.cpp). For most activation function types these 
+// constants can be moved into the weighted connections instead:
+//
+// - where the function is of the form f(slope * x) the slope value is
+//   multiplied into the connections feeding the layer
+// - for the Gaussian and ISRU functions the connections feeding the
+//   layer are multiplied by sqrt(slope) (with the ISRU amplify value
+//   divided by sqrt(slope) to compensate)
+// - the threshold function only tests the sign of its input so the
+//   slope value is multiplied into the amplify value
+// - the amplify value of a hidden layer is multiplied into the 
+//   connections leading from it to the next layer
+// - the amplify value of a linear layer is multiplied into the 
+//   connections feeding the layer
+//
+// The slope value of the SinC function cannot be folded as its small
+// input test is applied to the unscaled input value. The amplify 
+// value of a non-linear output layer is also left in place.
+//
+// Once folded a linear hidden layer simply passes on the weighted sum
+// of its inputs so it can be merged with the following layer by 
+// multiplying their weighted connection matrices together. This is 
+// only done if the merged connections need fewer multiplications and
+// at least one hidden layer always remains.
+//
+// These rewrites are exact apart from floating point rounding so the
+// optimised network should be checked against the original using the
+// validate method.
+/*
+		NNetOptimiser optimiser;
+		NeuralNet optimised;
+
+		if(optimiser.optimise(net, optimised) == 0 &&
+		   optimiser.validate(net, optimised, inputs) < 1e-12)
+		{
+			optimised.writeToFile("optimised.net");
+		}
+*/
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetOptimiser.h"
+
+/////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include <algorithm>
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// default constructor
+/// </summary>
+/// 
+NNetOptimiser::NNetOptimiser()
+{
+	mNumFolded = 0;
+	mNumMerged = 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// destructor
+/// </summary>
+///
+NNetOptimiser::~NNetOptimiser()
+{
+}
+
+/////////////////////////////////////////////////////////////////////
+// Public Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// produces an optimised copy of a network - the original network 
+/// is not altered
+/// </summary>
+/// <param name="net">the network to be optimised</param>
+/// <param name="optimised">the optimised network</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NNetOptimiser::optimise(const NeuralNet& net, NeuralNet& optimised)
+{
+	int numHidden = net.getNumLayers();
+
+	mNumFolded = 0;
+	mNumMerged = 0;
+
+	mConnects.clear();
+	mUnitTypes.clear();
+	mSlopes.clear();
+	mAmplifies.clear();
+
+	if(numHidden < 1)
+	{
+		return -1;
+	}
+
+	for(int i = 0; i <= numHidden; i++)
+	{
+		ActiveT unitType = net.getOutputUnitType();
+		double slope = net.getOutputUnitSlope();
+		double amplify = net.getOutputUnitAmplify();
+
+		if(i < numHidden)
+		{
+			net.getLayerDetails(i, unitType, slope, amplify);
+		}
+
+		mConnects.push_back(net.getWeightedConnect(i));
+		mUnitTypes.push_back(unitType);
+		mSlopes.push_back(slope);
+		mAmplifies.push_back(amplify);
+	}
+
+	foldLayers();
+	mergeLayers();
+
+	return buildNetwork(net, optimised);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// compares the responses of two networks to a batch of input rows - 
+/// 
+/// The difference between each pair of output values is divided by
+/// the size of the original value (or by 1 for values smaller than 1).
+/// </summary>
+/// <param name="original">the original network</param>
+/// <param name="optimised">the optimised network</param>
+/// <param name="inputs">the input rows stored one after another</param>
+/// <returns>the largest difference found or -1 if the networks 
+///          cannot be compared</returns>
+/// 
+double NNetOptimiser::validate(const NeuralNet& original, const NeuralNet& optimised, 
+							   const vector<double>& inputs) const
+{
+	vector<double> originalOutputs;
+	vector<double> optimisedOutputs;
+	double maxError = 0;
+
+	if(original.getNumInputs() != optimised.getNumInputs() ||
+	   original.getNumOutputs() != optimised.getNumOutputs() ||
+	   original.getNumInputs() <= 0)
+	{
+		return -1;
+	}
+
+	original.getResponses(inputs, originalOutputs);
+	optimised.getResponses(inputs, optimisedOutputs);
+
+	for(int i = 0; i < (int)originalOutputs.size(); i++)
+	{
+		double error = fabs(originalOutputs[i] - optimisedOutputs[i]) / 
+					   max(1.0, fabs(originalOutputs[i]));
+
+		// a NaN in either network counts as a failure
+		if(!(error <= maxError))
+		{
+			maxError = (error == error) ? error : HUGE_VAL;
+		}
+	}
+
+	return maxError;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Private Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// folds the slope and amplify values of each layer into the weighted
+/// connections wherever the result is equivalent
+/// </summary>
+/// 
+void NNetOptimiser::foldLayers()
+{
+	int numLayers = (int)mConnects.size();
+
+	for(int i = 0; i < numLayers; i++)
+	{
+		// the scale factor for the connections feeding this layer
+		double scale = 1.0;
+		double slope = mSlopes[i];
+
+		switch(mUnitTypes[i])
+		{
+		case kUnipolar:
+		case kBipolar:
+		case kTanh:
+		case kArctan:
+		case kSin:
+		case kCos:
+		case kElliot:
+		case kLinear:
+		case kSoftSign:
+		case kSoftPlus:
+			scale = slope;
+			mSlopes[i] = 1.0;
+			break;
+
+		case kGauss:
+			scale = sqrt(slope);
+			mSlopes[i] = 1.0;
+			break;
+
+		case kISRU:
+			scale = sqrt(slope);
+			mAmplifies[i] /= scale;
+			mSlopes[i] = 1.0;
+			break;
+
+		case kThreshold:
+			mAmplifies[i] *= slope;
+			mSlopes[i] = 1.0;
+			break;
+
+		case kSinC:
+			break;
+		}
+
+		if(slope != mSlopes[i])
+		{
+			mNumFolded++;
+		}
+
+		// a linear layer is a plain weighted sum so its amplify value can also be moved
+		if(mUnitTypes[i] == kLinear && mAmplifies[i] != 1.0)
+		{
+			scale *= mAmplifies[i];
+			mAmplifies[i] = 1.0;
+			mNumFolded++;
+		}
+
+		// the amplify value of the previous hidden layer scales the inputs to this one
+		if(i > 0 && mAmplifies[i - 1] != 1.0)
+		{
+			scale *= mAmplifies[i - 1];
+			mAmplifies[i - 1] = 1.0;
+			mNumFolded++;
+		}
+
+		if(scale != 1.0)
+		{
+			scaleConnect(i, scale);
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// merges linear hidden layers, whose slope and amplify values have 
+/// been folded, into the following layer
+/// </summary>
+/// 
+void NNetOptimiser::mergeLayers()
+{
+	for(int i = (int)mConnects.size() - 2; i >= 0; i--)
+	{
+		int numHidden = (int)mConnects.size() - 1;
+
+		if(numHidden > 1 && mUnitTypes[i] == kLinear && 
+		   mSlopes[i] == 1.0 && mAmplifies[i] == 1.0)
+		{
+			const NNetWeightedConnect& first = mConnects[i];
+			const NNetWeightedConnect& second = mConnects[i + 1];
+
+			int nIn = first.getNumInputNodes();
+			int nMid = first.getNumOutputNodes();
+			int nOut = second.getNumOutputNodes();
+
+			// only merge if the merged connections are cheaper to apply
+			if((long long)nIn * nOut <= (long long)nMid * (nIn + nOut))
+			{
+				NNetWeightedConnect merged(nIn, nOut);
+				vector<double> firstWeights((size_t)nMid * nIn);
+				vector<double> secondRow, weights, mergedRow(nIn);
+
+				for(int k = 0; k < nMid; k++)
+				{
+					first.getWeightVector(k, weights);
+					copy(weights.begin(), weights.end(), firstWeights.begin() + (size_t)k * nIn);
+				}
+
+				for(int r = 0; r < nOut; r++)
+				{
+					second.getWeightVector(r, secondRow);
+					fill(mergedRow.begin(), mergedRow.end(), 0.0);
+
+					for(int k = 0; k < nMid; k++)
+					{
+						const double* firstRow = firstWeights.data() + (size_t)k * nIn;
+
+						for(int j = 0; j < nIn; j++)
+						{
+							mergedRow[j] += secondRow[k] * firstRow[j];
+						}
+					}
+
+					merged.setWeightVector(r, mergedRow);
+				}
+
+				mConnects[i + 1] = merged;
+
+				mConnects.erase(mConnects.begin() + i);
+				mUnitTypes.erase(mUnitTypes.begin() + i);
+				mSlopes.erase(mSlopes.begin() + i);
+				mAmplifies.erase(mAmplifies.begin() + i);
+
+				mNumMerged++;
+			}
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// multiplies all the weighted connections of a layer by a scale factor
+/// </summary>
+/// <param name="layer">the index of the layer's weighted connections</param>
+/// <param name="scale">the scale factor</param>
+/// 
+void NNetOptimiser::scaleConnect(int layer, double scale)
+{
+	NNetWeightedConnect& connect = mConnects[layer];
+	vector<double> weights;
+
+	for(int i = 0; i < connect.getNumOutputNodes(); i++)
+	{
+		connect.getWeightVector(i, weights);
+
+		for(int j = 0; j < (int)weights.size(); j++)
+		{
+			weights[j] *= scale;
+		}
+
+		connect.setWeightVector(i, weights);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// builds a network from the working layers
+/// </summary>
+/// <param name="net">the network being optimised</param>
+/// <param name="optimised">the optimised network</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NNetOptimiser::buildNetwork(const NeuralNet& net, NeuralNet& optimised) const
+{
+	int numHidden = (int)mConnects.size() - 1;
+
+	optimised.clearNeuralNetwork();
+	optimised.setNumInputs(net.getNumInputs());
+	optimised.setNumOutputs(net.getNumOutputs());
+	optimised.setOutputUnitType(mUnitTypes[numHidden]);
+	optimised.setOutputUnitSlope(mSlopes[numHidden]);
+	optimised.setOutputUnitAmplify(mAmplifies[numHidden]);
+
+	for(int i = 0; i < numHidden; i++)
+	{
+		if(optimised.addLayer(mConnects[i].getNumOutputNodes(), mUnitTypes[i], 
+							  2.0, mSlopes[i], mAmplifies[i]) != 0)
+		{
+			return -1;
+		}
+	}
+
+	for(int i = 0; i <= numHidden; i++)
+	{
+		optimised.setWeightedConnect(mConnects[i], i);
+	}
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
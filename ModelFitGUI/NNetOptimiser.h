@@ -0,0 +1,95 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NNetOptimiser class
+//
+// Author: Jason Jenkins
+//
+// This class produces an equivalent but cheaper copy of a trained 
+// neural network (NeuralNet) by folding the activation function
+// slope and amplify values into the weighted connections and merging
+// linear hidden layers into their neighbours.
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////
+
+#include "NeuralNet.h"
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class produces an equivalent but cheaper copy of a trained 
+/// neural network (NeuralNet) by folding the activation function
+/// slope and amplify values into the weighted connections and merging
+/// linear hidden layers into their neighbours.
+/// </summary>
+/// 
+class NNetOptimiser
+{
+public:
+	NNetOptimiser();
+	virtual ~NNetOptimiser();
+
+	// produces an optimised copy of a network
+	int optimise(const NeuralNet& net, NeuralNet& optimised);
+
+	// compares the responses of two networks to a batch of input rows
+	double validate(const NeuralNet& original, const NeuralNet& optimised, 
+					const vector<double>& inputs) const;
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of slope and amplify values folded by the last optimisation</returns>
+	int getNumFolded() const { return mNumFolded; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of hidden layers merged by the last optimisation</returns>
+	int getNumMerged() const { return mNumMerged; }
+
+private:
+	// folds the slope and amplify values of each layer into the weighted connections
+	void foldLayers();
+
+	// merges linear hidden layers into the following layer
+	void mergeLayers();
+
+	// multiplies all the weighted connections of a layer by a scale factor
+	void scaleConnect(int layer, double scale);
+
+	// builds a network from the working layers
+	int buildNetwork(const NeuralNet& net, NeuralNet& optimised) const;
+
+private:
+	/// <summary>the number of slope and amplify values folded by the last optimisation</summary>
+	int mNumFolded;
+
+	/// <summary>the number of hidden layers merged by the last optimisation</summary>
+	int mNumMerged;
+
+	/// <summary>
+	/// the weighted connections being optimised - the last entry holds
+	/// the connections to the output layer
+	/// </summary>
+	vector<NNetWeightedConnect> mConnects;
+
+	/// <summary>the unit activation function types (the last entry is the output layer)</summary>
+	vector<ActiveT> mUnitTypes;
+
+	/// <summary>the unit activation function slope values (the last entry is the output layer)</summary>
+	vector<double> mSlopes;
+
+	/// <summary>the unit activation function amplify values (the last entry is the output layer)</summary>
+	vector<double> mAmplifies;
+};
+
+/////////////////////////////////////////////////////////////////////
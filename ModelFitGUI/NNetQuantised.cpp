@@ -0,0 +1,719 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Implements the NNetQuantised class
+//
+// Author: Jason Jenkins
+//
+// This class is a read only copy of a trained neural network
+// (NeuralNet) whose weighted connections and layer activations are
+// quantised to 8 or 16 bit integers.
+//
+// Quantising the network trades a small loss of accuracy for a much
+// smaller set of weighted connections (an eighth or a quarter of the
+// size of the double values) and integer dot products that process
+// 8 or 16 values per instruction.
+//
+// Each row of weighted connections (the weights feeding one unit) is
+// given its own scale so that its largest weight maps onto the
+// largest quantised value. The values feeding each layer share a
+// single scale which is calibrated by passing a sample of input rows
+// through the original network and recording the largest value seen
+// at each layer. Values outside the calibrated range are clamped so
+// the sample should be representative of the data to be scored.
+//
+// The integer dot product of a weight row and the quantised layer
+// inputs is converted back to a double using the two scales before
+// the layer's activation function is applied in full precision. The
+// activation function is therefore unchanged and only the weighted
+// connections and the values passed between layers lose precision.
+/*
+		NNetQuantised quantised;
+		vector<string> inputCols(1, "age");
+
+		quantised.quantise(net, sample, inputCols, scaleFactor, 8);
+		cout << quantised.getAccuracyReport(net, sample, inputCols, scaleFactor);
+
+		quantised.getResponses(inputs, outputs);
+*/
+// With 8 bit values the integer dot products are accumulated in 32
+// bit lanes over blocks of inputs and the block sums are added as 
+// doubles, so they are exact for any realistic layer size.
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetQuantised.h"
+
+/////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include <algorithm>
+#include <sstream>
+
+/////////////////////////////////////////////////////////////////////
+/// Use the SSE2 integer instructions where they are available
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define NNET_QUANTISED_SSE2
+#include <emmintrin.h>
+#endif
+
+/////////////////////////////////////////////////////////////////////
+/// The stored weight rows are padded with zeros to a multiple of this
+/// length so the dot product kernels have no remainder loop
+
+static const int kRowPadding = 16;
+
+/////////////////////////////////////////////////////////////////////
+/// The number of 8 bit inputs summed in 32 bit lanes before the sums
+/// are added as doubles - each lane then holds at most 16384 products
+/// of magnitude 127 * 127 which is well within 32 bits
+
+static const int kInt8BlockSize = 65536;
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the largest quantised value for a given number of bits
+/// </summary>
+/// <param name="numBits">the number of bits (8 or 16)</param>
+/// <returns>the largest quantised value</returns>
+/// 
+static double getQuantisedMax(int numBits)
+{
+	return (numBits == 8) ? 127.0 : 32767.0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// quantises a value - the value is rounded to the nearest integer
+/// and clamped to the symmetric range -qMax to +qMax
+/// </summary>
+/// <param name="value">the value to quantise</param>
+/// <param name="invScale">the reciprocal of the quantisation scale</param>
+/// <param name="qMax">the largest quantised value</param>
+/// <returns>the quantised value</returns>
+/// 
+template<typename T>
+static T quantiseValue(double value, double invScale, double qMax)
+{
+	double q = floor(value * invScale + 0.5);
+
+	if(q > qMax)
+	{
+		q = qMax;
+	}
+	else if(q < -qMax)
+	{
+		q = -qMax;
+	}
+	else if(q != q)
+	{
+		// NaN inputs are treated as zero
+		q = 0;
+	}
+
+	return (T)q;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// calculates the dot product of two 8 bit vectors - the length
+/// must be a multiple of 16
+/// 
+/// The 32 bit lane sums of each block of inputs are converted to 
+/// doubles before they are added together, so neither the lanes nor
+/// the final sum can overflow.
+/// </summary>
+/// <param name="a">the first vector</param>
+/// <param name="b">the second vector</param>
+/// <param name="n">the length of the vectors</param>
+/// <returns>the dot product</returns>
+/// 
+static double dotProduct(const signed char* a, const signed char* b, int n)
+{
+#ifdef NNET_QUANTISED_SSE2
+	__m128d total = _mm_setzero_pd();
+
+	for(int start = 0; start < n; start += kInt8BlockSize)
+	{
+		int end = min(n, start + kInt8BlockSize);
+		__m128i sum = _mm_setzero_si128();
+
+		for(int i = start; i < end; i += 16)
+		{
+			__m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+			__m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+
+			// sign extend the bytes to 16 bits
+			__m128i aLo = _mm_srai_epi16(_mm_unpacklo_epi8(va, va), 8);
+			__m128i aHi = _mm_srai_epi16(_mm_unpackhi_epi8(va, va), 8);
+			__m128i bLo = _mm_srai_epi16(_mm_unpacklo_epi8(vb, vb), 8);
+			__m128i bHi = _mm_srai_epi16(_mm_unpackhi_epi8(vb, vb), 8);
+
+			// multiply and add adjacent pairs into 32 bit sums
+			sum = _mm_add_epi32(sum, _mm_madd_epi16(aLo, bLo));
+			sum = _mm_add_epi32(sum, _mm_madd_epi16(aHi, bHi));
+		}
+
+		// add the four lane sums as doubles
+		total = _mm_add_pd(total, _mm_cvtepi32_pd(sum));
+		total = _mm_add_pd(total, _mm_cvtepi32_pd(_mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2))));
+	}
+
+	total = _mm_add_sd(total, _mm_unpackhi_pd(total, total));
+
+	return _mm_cvtsd_f64(total);
+#else
+	long long sum = 0;
+
+	for(int i = 0; i < n; i++)
+	{
+		sum += a[i] * b[i];
+	}
+
+	return (double)sum;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// calculates the dot product of two 16 bit vectors - the length
+/// must be a multiple of 8
+/// 
+/// The products of adjacent pairs fit in 32 bits and are summed as
+/// doubles which is exact for any realistic layer size.
+/// </summary>
+/// <param name="a">the first vector</param>
+/// <param name="b">the second vector</param>
+/// <param name="n">the length of the vectors</param>
+/// <returns>the dot product</returns>
+/// 
+static double dotProduct(const short* a, const short* b, int n)
+{
+#ifdef NNET_QUANTISED_SSE2
+	__m128d sumLo = _mm_setzero_pd();
+	__m128d sumHi = _mm_setzero_pd();
+
+	for(int i = 0; i < n; i += 8)
+	{
+		__m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+		__m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+
+		// multiply and add adjacent pairs into 32 bit sums
+		__m128i pairs = _mm_madd_epi16(va, vb);
+
+		sumLo = _mm_add_pd(sumLo, _mm_cvtepi32_pd(pairs));
+		sumHi = _mm_add_pd(sumHi, _mm_cvtepi32_pd(_mm_shuffle_epi32(pairs, _MM_SHUFFLE(1, 0, 3, 2))));
+	}
+
+	sumLo = _mm_add_pd(sumLo, sumHi);
+	sumLo = _mm_add_sd(sumLo, _mm_unpackhi_pd(sumLo, sumLo));
+
+	return _mm_cvtsd_f64(sumLo);
+#else
+	long long sum = 0;
+
+	for(int i = 0; i < n; i++)
+	{
+		sum += a[i] * b[i];
+	}
+
+	return (double)sum;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// default constructor
+/// </summary>
+/// 
+NNetQuantised::NNetQuantised()
+{
+	clearQuantisedNetwork();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// destructor
+/// </summary>
+/// 
+NNetQuantised::~NNetQuantised()
+{
+}
+
+/////////////////////////////////////////////////////////////////////
+// Public Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// clears the quantised network ready for re-use
+/// </summary>
+/// 
+void NNetQuantised::clearQuantisedNetwork()
+{
+	mNumBits = 8;
+	mNumInputs = 0;
+	mNumOutputs = 0;
+	mMaxStride = 0;
+	mMaxLayerSize = 0;
+
+	mWeights8.clear();
+	mWeights16.clear();
+	mRowScales.clear();
+	mLayerOffsets.clear();
+	mScaleOffsets.clear();
+	mLayerSizes.clear();
+	mLayerInputs.clear();
+	mLayerStrides.clear();
+	mInputScales.clear();
+	mLayerTypes.clear();
+	mLayerSlope.clear();
+	mLayerAmplify.clear();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// quantises a network using a sample of input rows to calibrate the
+/// scale of the values passed into each layer
+/// </summary>
+/// <param name="net">the network to be quantised</param>
+/// <param name="sampleInputs">the sample input rows stored one after another</param>
+/// <param name="numBits">the number of bits used by the quantised values (8 or 16)</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NNetQuantised::quantise(const NeuralNet& net, const vector<double>& sampleInputs, int numBits)
+{
+	int numHidden = net.getNumLayers();
+	int nIn = net.getNumInputs();
+
+	clearQuantisedNetwork();
+
+	if((numBits != 8 && numBits != 16) || numHidden < 1 || nIn <= 0 ||
+	   (int)sampleInputs.size() < nIn)
+	{
+		return -1;
+	}
+
+	int numRows = (int)sampleInputs.size() / nIn;
+	double qMax = getQuantisedMax(numBits);
+
+	// calibrate - find the largest value passed into each layer
+	vector<double> maxInputs(numHidden + 1, 0.0);
+	vector<double> row(nIn), outputs;
+	NNetWorkspace workspace;
+
+	for(int r = 0; r < numRows; r++)
+	{
+		row.assign(sampleInputs.begin() + (size_t)r * nIn, sampleInputs.begin() + (size_t)(r + 1) * nIn);
+
+		net.getResponse(row, outputs, workspace);
+
+		for(int i = 0; i <= numHidden; i++)
+		{
+			const double* values = (i == 0) ? row.data() : workspace.getActivations(i - 1);
+			int numValues = (i == 0) ? nIn : workspace.getLayerSize(i - 1);
+
+			for(int j = 0; j < numValues; j++)
+			{
+				maxInputs[i] = max(maxInputs[i], fabs(values[j]));
+			}
+		}
+	}
+
+	mNumBits = numBits;
+	mNumInputs = nIn;
+	mNumOutputs = net.getNumOutputs();
+
+	// quantise the weighted connections one row at a time
+	for(int i = 0; i <= numHidden; i++)
+	{
+		const NNetWeightedConnect& connect = net.getWeightedConnect(i);
+		ActiveT unitType = net.getOutputUnitType();
+		double slope = net.getOutputUnitSlope();
+		double amplify = net.getOutputUnitAmplify();
+
+		if(i < numHidden)
+		{
+			net.getLayerDetails(i, unitType, slope, amplify);
+		}
+
+		int nLayerIn = connect.getNumInputNodes();
+		int nUnits = connect.getNumOutputNodes();
+		int stride = (nLayerIn + kRowPadding - 1) / kRowPadding * kRowPadding;
+
+		mLayerOffsets.push_back(mNumBits == 8 ? (int)mWeights8.size() : (int)mWeights16.size());
+		mScaleOffsets.push_back((int)mRowScales.size());
+		mLayerSizes.push_back(nUnits);
+		mLayerInputs.push_back(nLayerIn);
+		mLayerStrides.push_back(stride);
+		mInputScales.push_back(maxInputs[i] > 0 ? maxInputs[i] / qMax : 1.0);
+		mLayerTypes.push_back(unitType);
+		mLayerSlope.push_back(slope);
+		mLayerAmplify.push_back(amplify);
+
+		mMaxStride = max(mMaxStride, stride);
+		mMaxLayerSize = max(mMaxLayerSize, nUnits);
+
+		vector<double> weights;
+
+		for(int u = 0; u < nUnits; u++)
+		{
+			double maxWeight = 0;
+
+			connect.getWeightVector(u, weights);
+
+			for(int j = 0; j < nLayerIn; j++)
+			{
+				maxWeight = max(maxWeight, fabs(weights[j]));
+			}
+
+			double rowScale = (maxWeight > 0) ? maxWeight / qMax : 1.0;
+
+			mRowScales.push_back(rowScale);
+
+			for(int j = 0; j < stride; j++)
+			{
+				double weight = (j < nLayerIn) ? weights[j] : 0.0;
+
+				if(mNumBits == 8)
+				{
+					mWeights8.push_back(quantiseValue<signed char>(weight, 1.0 / rowScale, qMax));
+				}
+				else
+				{
+					mWeights16.push_back(quantiseValue<short>(weight, 1.0 / rowScale, qMax));
+				}
+			}
+		}
+	}
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// quantises a network using the sample rows in a table to calibrate
+/// the scale of the values passed into each layer
+/// </summary>
+/// <param name="net">the network to be quantised</param>
+/// <param name="sample">the table holding the sample rows</param>
+/// <param name="inputCols">the names of the columns holding the network inputs</param>
+/// <param name="scaleFactor">the table values are divided by this value
+///                           (as they were for training)</param>
+/// <param name="numBits">the number of bits used by the quantised values (8 or 16)</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NNetQuantised::quantise(const NeuralNet& net, DbaseTable& sample, const vector<string>& inputCols,
+							double scaleFactor, int numBits)
+{
+	vector<double> sampleInputs;
+
+	if((int)inputCols.size() != net.getNumInputs() ||
+	   getTableInputs(sample, inputCols, scaleFactor, sampleInputs) <= 0)
+	{
+		clearQuantisedNetwork();
+
+		return -1;
+	}
+
+	return quantise(net, sampleInputs, numBits);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the number of bytes used by the quantised weighted connections
+/// </summary>
+/// <returns>the number of bytes</returns>
+/// 
+int NNetQuantised::getWeightBytes() const
+{
+	return (int)(mWeights8.size() * sizeof(signed char) + mWeights16.size() * sizeof(short));
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the response of the network to the given input
+/// </summary>
+/// <param name="inputs">the network input values</param>
+/// <param name="outputs">the network output values</param>
+/// 
+void NNetQuantised::getResponse(const vector<double>& inputs, vector<double>& outputs) const
+{
+	if((int)inputs.size() >= mNumInputs && !mLayerSizes.empty())
+	{
+		outputs.resize(mNumOutputs);
+
+		getResponses(inputs.data(), outputs.data(), 1);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the responses of the network to a batch of input rows - the
+/// inputs vector holds the input rows one after another
+/// </summary>
+/// <param name="inputs">the input rows</param>
+/// <param name="outputs">the output rows</param>
+/// 
+void NNetQuantised::getResponses(const vector<double>& inputs, vector<double>& outputs) const
+{
+	if(mNumInputs > 0)
+	{
+		int numRows = (int)inputs.size() / mNumInputs;
+
+		outputs.resize((size_t)numRows * mNumOutputs);
+
+		getResponses(inputs.data(), outputs.data(), numRows);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the responses of the network to a batch of input rows
+/// </summary>
+/// <param name="inputs">the input rows (numRows x the number of inputs)</param>
+/// <param name="outputs">the output rows (numRows x the number of outputs)</param>
+/// <param name="numRows">the number of rows</param>
+/// 
+void NNetQuantised::getResponses(const double* inputs, double* outputs, int numRows) const
+{
+	if(mLayerSizes.empty() || numRows <= 0)
+	{
+		return;
+	}
+
+	if(mNumBits == 8)
+	{
+		getQuantisedResponses(mWeights8, inputs, outputs, numRows);
+	}
+	else
+	{
+		getQuantisedResponses(mWeights16, inputs, outputs, numRows);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// compares the quantised responses with those of the original network
+/// </summary>
+/// <param name="net">the original network</param>
+/// <param name="inputs">the input rows stored one after another</param>
+/// <param name="maxErrors">receives the largest absolute error for each output</param>
+/// <param name="rmsErrors">receives the root mean square error for each output</param>
+/// <returns>the number of rows compared or -1 if the networks cannot be compared</returns>
+/// 
+int NNetQuantised::compareResponses(const NeuralNet& net, const vector<double>& inputs,
+									vector<double>& maxErrors, vector<double>& rmsErrors) const
+{
+	if(mLayerSizes.empty() || net.getNumInputs() != mNumInputs ||
+	   net.getNumOutputs() != mNumOutputs)
+	{
+		return -1;
+	}
+
+	vector<double> netOutputs, quantisedOutputs;
+	int numRows = (int)inputs.size() / mNumInputs;
+
+	net.getResponses(inputs, netOutputs);
+	getResponses(inputs, quantisedOutputs);
+
+	maxErrors.assign(mNumOutputs, 0.0);
+	rmsErrors.assign(mNumOutputs, 0.0);
+
+	for(int r = 0; r < numRows; r++)
+	{
+		for(int k = 0; k < mNumOutputs; k++)
+		{
+			size_t idx = (size_t)r * mNumOutputs + k;
+			double error = fabs(netOutputs[idx] - quantisedOutputs[idx]);
+
+			maxErrors[k] = max(maxErrors[k], error);
+			rmsErrors[k] += error * error;
+		}
+	}
+
+	for(int k = 0; k < mNumOutputs; k++)
+	{
+		if(numRows > 0)
+		{
+			rmsErrors[k] = sqrt(rmsErrors[k] / numRows);
+		}
+	}
+
+	return numRows;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// generates a report comparing the quantised responses with those
+/// of the original network over the rows in a table
+/// </summary>
+/// <param name="net">the original network</param>
+/// <param name="sample">the table holding the rows to compare</param>
+/// <param name="inputCols">the names of the columns holding the network inputs</param>
+/// <param name="scaleFactor">the table values are divided by this value
+///                           (as they were for training)</param>
+/// <returns>the report text</returns>
+/// 
+string NNetQuantised::getAccuracyReport(const NeuralNet& net, DbaseTable& sample,
+										const vector<string>& inputCols, double scaleFactor) const
+{
+	ostringstream report;
+	vector<double> inputs, maxErrors, rmsErrors;
+	int numRows = -1;
+
+	if((int)inputCols.size() == mNumInputs &&
+	   getTableInputs(sample, inputCols, scaleFactor, inputs) > 0)
+	{
+		numRows = compareResponses(net, inputs, maxErrors, rmsErrors);
+	}
+
+	if(numRows < 0)
+	{
+		report << "The quantised network could not be compared with the original network" << endl;
+
+		return report.str();
+	}
+
+	int numWeights = 0;
+
+	for(int i = 0; i < (int)mLayerSizes.size(); i++)
+	{
+		numWeights += mLayerSizes[i] * mLayerInputs[i];
+	}
+
+	report << "Quantised network accuracy (" << mNumBits << " bit weights and activations)" << endl;
+	report << "Rows compared: " << numRows << endl;
+	report << "Weight storage: " << getWeightBytes() << " bytes ("
+		   << numWeights * sizeof(double) << " bytes unquantised)" << endl;
+
+	for(int k = 0; k < mNumOutputs; k++)
+	{
+		report << "Output " << k + 1 << ": max error = " << maxErrors[k]
+			   << ", rms error = " << rmsErrors[k] << endl;
+	}
+
+	return report.str();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// reads the input rows for a set of columns from a table - the rows
+/// are stored one after another
+/// </summary>
+/// <param name="table">the table</param>
+/// <param name="inputCols">the names of the columns holding the inputs</param>
+/// <param name="scaleFactor">the table values are divided by this value</param>
+/// <param name="inputs">receives the input rows</param>
+/// <returns>the number of rows or -1 if a column cannot be read</returns>
+/// 
+int NNetQuantised::getTableInputs(DbaseTable& table, const vector<string>& inputCols,
+								  double scaleFactor, vector<double>& inputs)
+{
+	int nCols = (int)inputCols.size();
+	int numRows = table.getNumRows();
+	vector<double> column;
+
+	inputs.clear();
+
+	if(nCols <= 0 || scaleFactor == 0)
+	{
+		return -1;
+	}
+
+	inputs.resize((size_t)numRows * nCols);
+
+	for(int c = 0; c < nCols; c++)
+	{
+		if(table.getNumericCol(inputCols[c], column) != 0 || (int)column.size() < numRows)
+		{
+			inputs.clear();
+
+			return -1;
+		}
+
+		for(int r = 0; r < numRows; r++)
+		{
+			inputs[(size_t)r * nCols + c] = column[r] / scaleFactor;
+		}
+	}
+
+	return numRows;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Private Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// calculates the responses using quantised values of the given type -
+/// 
+/// The values passed into each layer are quantised with the layer's
+/// input scale, multiplied by each quantised weight row and converted
+/// back using the input and row scales before being activated.
+/// </summary>
+/// <param name="weights">the quantised weights</param>
+/// <param name="inputs">the input rows (numRows x the number of inputs)</param>
+/// <param name="outputs">the output rows (numRows x the number of outputs)</param>
+/// <param name="numRows">the number of rows</param>
+/// 
+template<typename T>
+void NNetQuantised::getQuantisedResponses(const vector<T>& weights, const double* inputs,
+										  double* outputs, int numRows) const
+{
+	int numLayers = (int)mLayerSizes.size();
+	double qMax = getQuantisedMax(mNumBits);
+
+	vector<T> quantised(mMaxStride, 0);
+	vector<double> activations(mMaxLayerSize);
+	vector<ActivationFn> kernels(numLayers);
+
+	for(int i = 0; i < numLayers; i++)
+	{
+		kernels[i] = NNetUnit::getActivationFunction(mLayerTypes[i]);
+	}
+
+	for(int r = 0; r < numRows; r++)
+	{
+		const double* layerInputs = inputs + (size_t)r * mNumInputs;
+
+		for(int i = 0; i < numLayers; i++)
+		{
+			int nIn = mLayerInputs[i];
+			int nUnits = mLayerSizes[i];
+			int stride = mLayerStrides[i];
+			double inputScale = mInputScales[i];
+			double invScale = 1.0 / inputScale;
+
+			// the layer inputs are quantised before the activations buffer is overwritten
+			for(int j = 0; j < nIn; j++)
+			{
+				quantised[j] = quantiseValue<T>(layerInputs[j], invScale, qMax);
+			}
+
+			for(int j = nIn; j < stride; j++)
+			{
+				quantised[j] = 0;
+			}
+
+			const T* layerWeights = weights.data() + mLayerOffsets[i];
+			const double* rowScales = mRowScales.data() + mScaleOffsets[i];
+
+			for(int u = 0; u < nUnits; u++)
+			{
+				double dot = dotProduct(layerWeights + (size_t)u * stride, quantised.data(), stride);
+
+				activations[u] = dot * rowScales[u] * inputScale;
+			}
+
+			kernels[i](activations.data(), activations.data(), nUnits, mLayerSlope[i], mLayerAmplify[i]);
+
+			layerInputs = activations.data();
+		}
+
+		copy(activations.begin(), activations.begin() + mNumOutputs, outputs + (size_t)r * mNumOutputs);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
@@ -0,0 +1,153 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NNetQuantised class
+//
+// Author: Jason Jenkins
+//
+// This class is a read only copy of a trained neural network
+// (NeuralNet) whose weighted connections and layer activations are
+// quantised to 8 or 16 bit integers.
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <string>
+
+/////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////
+
+#include "NeuralNet.h"
+#include "DbaseTable.h"
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class is a read only copy of a trained neural network
+/// (NeuralNet) whose weighted connections and layer activations are
+/// quantised to 8 or 16 bit integers.
+/// </summary>
+/// 
+class NNetQuantised
+{
+public:
+	NNetQuantised();
+	virtual ~NNetQuantised();
+
+	// clears the quantised network ready for re-use
+	void clearQuantisedNetwork();
+
+	// quantises a network using a sample of input rows to calibrate the activation scales
+	int quantise(const NeuralNet& net, const vector<double>& sampleInputs, int numBits = 8);
+
+	// quantises a network using the sample rows in a table to calibrate the activation scales
+	int quantise(const NeuralNet& net, DbaseTable& sample, const vector<string>& inputCols,
+				 double scaleFactor = 1.0, int numBits = 8);
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of bits used by the quantised values (8 or 16)</returns>
+	int getNumBits() const { return mNumBits; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of input units</returns>
+	int getNumInputs() const { return mNumInputs; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of output units</returns>
+	int getNumOutputs() const { return mNumOutputs; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of layers (the hidden layers and the output layer)</returns>
+	int getNumLayers() const { return (int)mLayerSizes.size(); }
+
+	// gets the number of bytes used by the quantised weighted connections
+	int getWeightBytes() const;
+
+	// gets the response of the network to the given input
+	void getResponse(const vector<double>& inputs, vector<double>& outputs) const;
+
+	// gets the responses of the network to a batch of input rows
+	void getResponses(const vector<double>& inputs, vector<double>& outputs) const;
+	void getResponses(const double* inputs, double* outputs, int numRows) const;
+
+	// compares the quantised responses with those of the original network
+	int compareResponses(const NeuralNet& net, const vector<double>& inputs,
+						 vector<double>& maxErrors, vector<double>& rmsErrors) const;
+
+	// generates a report comparing the quantised responses with those of the original network
+	string getAccuracyReport(const NeuralNet& net, DbaseTable& sample,
+							 const vector<string>& inputCols, double scaleFactor = 1.0) const;
+
+	// reads the input rows for a set of columns from a table
+	static int getTableInputs(DbaseTable& table, const vector<string>& inputCols,
+							  double scaleFactor, vector<double>& inputs);
+
+private:
+	// calculates the responses using quantised values of the given type
+	template<typename T>
+	void getQuantisedResponses(const vector<T>& weights, const double* inputs,
+							   double* outputs, int numRows) const;
+
+private:
+	/// <summary>the number of bits used by the quantised values (8 or 16)</summary>
+	int mNumBits;
+
+	/// <summary>the number of input units</summary>
+	int mNumInputs;
+
+	/// <summary>the number of output units</summary>
+	int mNumOutputs;
+
+	/// <summary>the largest layer row length (including padding)</summary>
+	int mMaxStride;
+
+	/// <summary>the largest number of units in a layer</summary>
+	int mMaxLayerSize;
+
+	/// <summary>the 8 bit quantised weights (used if mNumBits is 8)</summary>
+	vector<signed char> mWeights8;
+
+	/// <summary>the 16 bit quantised weights (used if mNumBits is 16)</summary>
+	vector<short> mWeights16;
+
+	/// <summary>the scale of the quantised weights for each unit of every layer</summary>
+	vector<double> mRowScales;
+
+	/// <summary>the start of each layer's quantised weights</summary>
+	vector<int> mLayerOffsets;
+
+	/// <summary>the start of each layer's weight scales</summary>
+	vector<int> mScaleOffsets;
+
+	/// <summary>the number of units in each layer</summary>
+	vector<int> mLayerSizes;
+
+	/// <summary>the number of inputs to each layer</summary>
+	vector<int> mLayerInputs;
+
+	/// <summary>the length of each stored weight row - the number of inputs padded for the kernels</summary>
+	vector<int> mLayerStrides;
+
+	/// <summary>the scale of the quantised input values to each layer</summary>
+	vector<double> mInputScales;
+
+	/// <summary>the layer unit activation function types</summary>
+	vector<ActiveT> mLayerTypes;
+
+	/// <summary>the layer unit activation function slope values</summary>
+	vector<double> mLayerSlope;
+
+	/// <summary>the layer unit activation function amplify values</summary>
+	vector<double> mLayerAmplify;
+};
+
+/////////////////////////////////////////////////////////////////////
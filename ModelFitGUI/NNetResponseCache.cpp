@@ -0,0 +1,211 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Implements the NNetResponseCache class
+//
+// Author: Jason Jenkins
+//
+// This class is a bounded least recently used (LRU) cache of neural
+// network (NeuralNet) responses.
+//
+// Online callers that score one input at a time often see the same
+// input values again and again. Passing such requests through a 
+// response cache means each distinct input only has to be evaluated
+// by the network once while it remains in the cache. Once the cache
+// is full the least recently used response is discarded to make room
+// for a new one. Input vectors only match if their values are 
+// identical bit for bit so a cached response is always exactly the 
+// response the network would have calculated.
+/*
+		NNetResponseCache cache(4096);
+		vector<double> outputs;
+
+		cache.getResponse(net, inputs, outputs);
+*/
+// The cache does not keep track of the network that produced its 
+// responses so it must be cleared (via clearCache) if it is used with
+// a different network or the network is re-trained. A cache object
+// is not thread safe - each thread should use its own cache.
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetResponseCache.h"
+
+/////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// default constructor - the cache holds up to 1024 responses
+/// </summary>
+/// 
+NNetResponseCache::NNetResponseCache()
+{
+	mCapacity = 1024;
+	mNumHits = 0;
+	mNumMisses = 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// constructs a cache holding up to the given number of responses
+/// </summary>
+/// <param name="capacity">the maximum number of cached responses</param>
+/// 
+NNetResponseCache::NNetResponseCache(int capacity)
+{
+	mCapacity = 1024;
+	mNumHits = 0;
+	mNumMisses = 0;
+
+	setCapacity(capacity);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// destructor
+/// </summary>
+///
+NNetResponseCache::~NNetResponseCache()
+{
+}
+
+/////////////////////////////////////////////////////////////////////
+// Public Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// clears all the cached responses and resets the hit and miss counts
+/// </summary>
+/// 
+void NNetResponseCache::clearCache()
+{
+	mEntries.clear();
+	mIndex.clear();
+
+	mNumHits = 0;
+	mNumMisses = 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets the maximum number of cached responses - if the cache holds
+/// more responses than this the least recently used are discarded
+/// </summary>
+/// <param name="capacity">the maximum number of cached responses</param>
+/// 
+void NNetResponseCache::setCapacity(int capacity)
+{
+	// ignore invalid values
+	if(capacity > 0)
+	{
+		mCapacity = capacity;
+
+		trimCache();
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the response of the network to the given input - the cached
+/// response is used if there is one otherwise the response is 
+/// calculated by the network and added to the cache
+/// </summary>
+/// <param name="net">the network</param>
+/// <param name="inputs">the network input values</param>
+/// <param name="outputs">the network output values</param>
+/// 
+void NNetResponseCache::getResponse(const NeuralNet& net, const vector<double>& inputs, vector<double>& outputs)
+{
+	int nIn = net.getNumInputs();
+
+	if((int)inputs.size() < nIn || nIn <= 0)
+	{
+		return;
+	}
+
+	// any additional input values are ignored by the network so they are not part of the key
+	mKey.assign(inputs.begin(), inputs.begin() + nIn);
+
+	auto found = mIndex.find(mKey);
+
+	if(found != mIndex.end())
+	{
+		// move the entry to the front of the list - it is now the most recently used
+		mEntries.splice(mEntries.begin(), mEntries, found->second);
+
+		outputs = found->second->second;
+		mNumHits++;
+	}
+	else
+	{
+		net.getResponse(mKey, outputs, mWorkspace);
+		mNumMisses++;
+
+		mEntries.push_front(CacheEntry(mKey, outputs));
+		mIndex[mKey] = mEntries.begin();
+
+		trimCache();
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+// Private Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// removes the least recently used responses until the cache is 
+/// within its capacity
+/// </summary>
+/// 
+void NNetResponseCache::trimCache()
+{
+	while((int)mEntries.size() > mCapacity)
+	{
+		mIndex.erase(mEntries.back().first);
+		mEntries.pop_back();
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// hashes an input vector using the bit patterns of its values - each
+/// 64 bit value is xored in and multiplied by the FNV prime in turn
+/// </summary>
+/// <param name="key">the input vector</param>
+/// <returns>the hash value</returns>
+/// 
+size_t NNetResponseCache::InputHash::operator()(const vector<double>& key) const
+{
+	unsigned long long hash = 14695981039346656037ULL;
+
+	for(int i = 0; i < (int)key.size(); i++)
+	{
+		unsigned long long bits;
+
+		memcpy(&bits, &key[i], sizeof(bits));
+
+		hash ^= bits;
+		hash *= 1099511628211ULL;
+	}
+
+	return (size_t)(hash ^ (hash >> 32));
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// compares input vectors using the bit patterns of their values
+/// </summary>
+/// <param name="a">the first input vector</param>
+/// <param name="b">the second input vector</param>
+/// <returns>true if the vectors are identical</returns>
+/// 
+bool NNetResponseCache::InputEqual::operator()(const vector<double>& a, const vector<double>& b) const
+{
+	return a.size() == b.size() && 
+		   (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0);
+}
+
+/////////////////////////////////////////////////////////////////////
@@ -0,0 +1,118 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NNetResponseCache class
+//
+// Author: Jason Jenkins
+//
+// This class is a bounded least recently used (LRU) cache of neural
+// network (NeuralNet) responses.
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+
+/////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////
+
+#include "NeuralNet.h"
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class is a bounded least recently used (LRU) cache of neural
+/// network (NeuralNet) responses.
+/// </summary>
+/// 
+class NNetResponseCache
+{
+public:
+	NNetResponseCache();
+	virtual ~NNetResponseCache();
+
+	// constructs a cache holding up to the given number of responses
+	NNetResponseCache(int capacity);
+
+	// clears all the cached responses
+	void clearCache();
+
+	// sets the maximum number of cached responses
+	void setCapacity(int capacity);
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the maximum number of cached responses</returns>
+	int getCapacity() const { return mCapacity; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of cached responses</returns>
+	int getSize() const { return (int)mEntries.size(); }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of responses found in the cache</returns>
+	long long getNumHits() const { return mNumHits; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of responses calculated by the network</returns>
+	long long getNumMisses() const { return mNumMisses; }
+
+	// gets the response of the network to the given input
+	void getResponse(const NeuralNet& net, const vector<double>& inputs, vector<double>& outputs);
+
+private:
+	// removes the least recently used responses until the cache is within capacity
+	void trimCache();
+
+	// a cache can not be copied - its index refers into its own list
+	NNetResponseCache(const NNetResponseCache&) = delete;
+	NNetResponseCache& operator=(const NNetResponseCache&) = delete;
+
+private:
+	/// <summary>hashes an input vector using the bit patterns of its values</summary>
+	struct InputHash
+	{
+		size_t operator()(const vector<double>& key) const;
+	};
+
+	/// <summary>compares input vectors using the bit patterns of their values</summary>
+	struct InputEqual
+	{
+		bool operator()(const vector<double>& a, const vector<double>& b) const;
+	};
+
+	/// <summary>a cached input vector and the corresponding response</summary>
+	typedef pair<vector<double>, vector<double> > CacheEntry;
+
+	/// <summary>the cached responses - the most recently used first</summary>
+	list<CacheEntry> mEntries;
+
+	/// <summary>maps an input vector to its entry in the cached responses</summary>
+	unordered_map<vector<double>, list<CacheEntry>::iterator, InputHash, InputEqual> mIndex;
+
+	/// <summary>the maximum number of cached responses</summary>
+	int mCapacity;
+
+	/// <summary>the number of responses found in the cache</summary>
+	long long mNumHits;
+
+	/// <summary>the number of responses calculated by the network</summary>
+	long long mNumMisses;
+
+	/// <summary>the working values used when calculating a response</summary>
+	NNetWorkspace mWorkspace;
+
+	/// <summary>the network inputs truncated to the number of input units</summary>
+	vector<double> mKey;
+};
+
+/////////////////////////////////////////////////////////////////////
@@ -0,0 +1,429 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Implements the NNetSurrogate class
+//
+// Author: Jason Jenkins
+//
+// This class is a fast piecewise polynomial approximation of a 
+// trained neural network with a single input and a single output.
+//
+// The networks fitted by the ModelFitGUI application map a single
+// predictor value (X) to a single response value (Y). When such a 
+// network has to be evaluated many times it can be replaced by an
+// approximation that is far cheaper to calculate.
+//
+// The build method divides a chosen range of X into a number of equal
+// width segments and, on each segment, fits a Chebyshev polynomial
+// to the network response by sampling the network at the Chebyshev
+// nodes of the segment. The fit is then checked by comparing the 
+// polynomials with the network on a dense grid of points covering
+// every segment. If the largest error found is above the requested
+// tolerance the number of segments is doubled and the process is 
+// repeated. The largest error found for the final approximation is
+// available from the getMaxError method - it is a measured value,
+// not a strict bound, but with the dense check grid and the smooth
+// activation functions it is a reliable guide. Discontinuous 
+// activation functions (threshold) may never reach the tolerance, in
+// which case build returns -1 but the approximation can still be used.
+//
+// Calculating a response only requires finding the segment, which is
+// a single multiplication as the segments have equal widths, and 
+// evaluating a low degree polynomial. Input values outside the range
+// are clamped to the range.
+/*
+		NNetSurrogate surrogate;
+
+		// approximate the network for x in 0 to 1 to within 1e-9
+		surrogate.build(net, 0.0, 1.0, 1e-9);
+
+		double y = surrogate.getResponse(0.25);
+*/
+// An approximation can be serialized to a file and re-loaded in the
+// same way as a NeuralNet object.
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetSurrogate.h"
+#include "NNetFrozen.h"
+
+/////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+
+/////////////////////////////////////////////////////////////////////
+
+// the number of check points within each segment used to measure the error
+static const int kCheckPointsPerSegment = 64;
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// default constructor
+/// </summary>
+/// 
+NNetSurrogate::NNetSurrogate()
+{
+	clearSurrogate();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// constructs a NNetSurrogate object from a file containing an 
+/// approximation in serialized form
+/// </summary>
+/// <param name="fname">the file containing the serialized data</param>
+/// 
+NNetSurrogate::NNetSurrogate(const string& fname)
+{
+	clearSurrogate();
+
+	ifstream inFile(fname);
+
+	if(inFile.good())
+	{
+		stringstream buffer;
+
+		buffer << inFile.rdbuf();
+
+		deserialize(buffer.str());
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// destructor
+/// </summary>
+///
+NNetSurrogate::~NNetSurrogate()
+{
+}
+
+/////////////////////////////////////////////////////////////////////
+// Public Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// clears a NNetSurrogate object ready for re-use
+/// </summary>
+/// 
+void NNetSurrogate::clearSurrogate()
+{
+	mMinX = 0;
+	mMaxX = 0;
+	mScale = 0;
+	mDegree = 0;
+	mNumSegments = 0;
+	mMaxError = 0;
+
+	mCoeffs.clear();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// builds the approximation of the given network over the given range - 
+/// 
+/// The number of segments is doubled until the largest measured error
+/// is within the tolerance or the maximum number of segments is reached.
+/// </summary>
+/// <param name="net">the trained network (one input and one output)</param>
+/// <param name="xMin">the lower limit of the range</param>
+/// <param name="xMax">the upper limit of the range</param>
+/// <param name="tolerance">the largest acceptable error</param>
+/// <param name="degree">the degree of the segment polynomials (defaults to 8)</param>
+/// <param name="maxSegments">the maximum number of segments (defaults to 4096)</param>
+///
+/// <returns>0 if the tolerance is met otherwise -1</returns>
+/// 
+int NNetSurrogate::build(const NeuralNet& net, double xMin, double xMax, double tolerance,
+						 int degree, int maxSegments)
+{
+	clearSurrogate();
+
+	// ignore invalid values
+	if(net.getNumInputs() != 1 || net.getNumOutputs() != 1 || net.getNumLayers() <= 0 ||
+	   xMax <= xMin || tolerance <= 0 || degree < 1 || maxSegments < 1)
+	{
+		return -1;
+	}
+
+	NNetFrozen frozen = net.freeze();
+
+	mMinX = xMin;
+	mMaxX = xMax;
+	mDegree = degree;
+
+	for(int nSegments = 1; ; nSegments *= 2)
+	{
+		mNumSegments = min(nSegments, maxSegments);
+		mScale = mNumSegments / (mMaxX - mMinX);
+
+		fitSegments(frozen);
+		mMaxError = measureError(frozen);
+
+		if(mMaxError <= tolerance)
+		{
+			return 0;
+		}
+
+		if(mNumSegments >= maxSegments)
+		{
+			return -1;
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the approximate network response to the given input - input
+/// values outside the approximated range are clamped to the range and
+/// a NaN input gives a NaN response
+/// </summary>
+/// <param name="x">the input value</param>
+/// <returns>the approximate network response</returns>
+/// 
+double NNetSurrogate::getResponse(double x) const
+{
+	if(mNumSegments <= 0)
+	{
+		return 0;
+	}
+
+	// a NaN input would fail both of the range checks below
+	if(isnan(x))
+	{
+		return x;
+	}
+
+	// find the segment containing x and its position within the segment
+	// (written so that a NaN position is also clamped)
+	double s = (x - mMinX) * mScale;
+
+	if(!(s >= 0)) s = 0;
+	if(s > mNumSegments) s = mNumSegments;
+
+	int seg = (int)s;
+
+	if(seg == mNumSegments) seg--;
+
+	// map the position onto the Chebyshev interval -1 to +1
+	double t = 2 * (s - seg) - 1;
+	double t2 = 2 * t;
+
+	// evaluate the Chebyshev series using Clenshaw's recurrence
+	const double* c = mCoeffs.data() + seg * (mDegree + 1);
+	double b1 = 0, b2 = 0;
+
+	for(int k = mDegree; k >= 1; k--)
+	{
+		double b0 = c[k] + t2 * b1 - b2;
+
+		b2 = b1;
+		b1 = b0;
+	}
+
+	return c[0] + t * b1 - b2;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// serializes this approximation and writes it to a file
+/// </summary>
+/// <param name="fname">the file to write the data to</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NNetSurrogate::writeToFile(const string& fname)
+{
+	ofstream outFile(fname);
+
+	if(outFile.good())
+	{
+		outFile << serialize();
+	}
+	else
+	{
+		return -1;
+	}
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Private Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// fits the segment polynomials using the network responses - the 
+/// network is sampled at the Chebyshev nodes of every segment and the
+/// series coefficients are found using the discrete cosine transform
+/// </summary>
+/// <param name="net">the network being approximated</param>
+/// 
+void NNetSurrogate::fitSegments(const NNetFrozen& net)
+{
+	const double pi = 3.14159265358979323846;
+	int nNodes = mDegree + 1;
+	double width = 1.0 / mScale;
+	vector<double> nodes(nNodes), xValues, yValues;
+
+	// the Chebyshev nodes on the interval -1 to +1
+	for(int j = 0; j < nNodes; j++)
+	{
+		nodes[j] = cos(pi * (j + 0.5) / nNodes);
+	}
+
+	// sample the network at the nodes of every segment
+	for(int s = 0; s < mNumSegments; s++)
+	{
+		double x0 = mMinX + s * width;
+
+		for(int j = 0; j < nNodes; j++)
+		{
+			xValues.push_back(x0 + 0.5 * width * (nodes[j] + 1));
+		}
+	}
+
+	net.getResponses(xValues, yValues);
+
+	mCoeffs.assign(mNumSegments * nNodes, 0.0);
+
+	for(int s = 0; s < mNumSegments; s++)
+	{
+		const double* y = yValues.data() + s * nNodes;
+		double* c = mCoeffs.data() + s * nNodes;
+
+		for(int k = 0; k < nNodes; k++)
+		{
+			double sum = 0;
+
+			for(int j = 0; j < nNodes; j++)
+			{
+				sum += y[j] * cos(pi * k * (j + 0.5) / nNodes);
+			}
+
+			c[k] = (k == 0 ? 1.0 : 2.0) * sum / nNodes;
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// measures the largest error between the approximation and the 
+/// network on a dense grid of points covering every segment
+/// </summary>
+/// <param name="net">the network being approximated</param>
+/// <returns>the largest absolute error found</returns>
+/// 
+double NNetSurrogate::measureError(const NNetFrozen& net) const
+{
+	int nPoints = mNumSegments * kCheckPointsPerSegment;
+	double step = (mMaxX - mMinX) / nPoints;
+	vector<double> xValues(nPoints + 1), yValues;
+	double maxError = 0;
+
+	for(int i = 0; i <= nPoints; i++)
+	{
+		xValues[i] = (i == nPoints) ? mMaxX : mMinX + i * step;
+	}
+
+	net.getResponses(xValues, yValues);
+
+	for(int i = 0; i <= nPoints; i++)
+	{
+		double error = fabs(getResponse(xValues[i]) - yValues[i]);
+
+		// a non-finite error can never be within the tolerance
+		if(!(error <= maxError))
+		{
+			maxError = error;
+		}
+	}
+
+	return maxError;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// generates a string representation of this approximation
+/// </summary>
+/// <returns>a string representation of this approximation</returns>
+/// 
+string NNetSurrogate::serialize()
+{
+	ostringstream outStream;
+
+	outStream << std::setprecision(17);
+
+	outStream << mMinX << " " <<
+				 mMaxX << " " <<
+				 mDegree << " " <<
+				 mNumSegments << " " <<
+				 mMaxError << " ";
+
+	for(int i = 0; i < (int)mCoeffs.size(); i++)
+	{
+		outStream << mCoeffs[i] << " ";
+	}
+
+	// terminate the output string
+	outStream << endl;
+
+	return outStream.str();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// instantiates this approximation from a given string representation
+/// </summary>
+/// <param name="inData">the given string representation of the approximation</param>
+/// 
+void NNetSurrogate::deserialize(const string& inData)
+{
+	istringstream inStream(inData);
+
+	inStream >> mMinX;
+	inStream >> mMaxX;
+	inStream >> mDegree;
+	inStream >> mNumSegments;
+	inStream >> mMaxError;
+
+	if(!inStream.good() || !isfinite(mMinX) || !isfinite(mMaxX) || mMaxX <= mMinX || 
+	   mDegree < 1 || mNumSegments < 1)
+	{
+		cerr << "Error deserializing!" << endl;
+		clearSurrogate();
+		return;
+	}
+
+	// as every coefficient takes at least two characters the coefficients
+	// must fit in the rest of the string before any memory is allocated
+	size_t numCoeffs = (size_t)mNumSegments * ((size_t)mDegree + 1);
+	size_t remaining = inData.size() - (size_t)inStream.tellg();
+
+	if(numCoeffs > (remaining + 1) / 2)
+	{
+		cerr << "Error deserializing!" << endl;
+		clearSurrogate();
+		return;
+	}
+
+	mScale = mNumSegments / (mMaxX - mMinX);
+	mCoeffs.resize(numCoeffs);
+
+	for(int i = 0; i < (int)mCoeffs.size(); i++)
+	{
+		inStream >> mCoeffs[i];
+	}
+
+	if(inStream.fail())
+	{
+		cerr << "Error deserializing!" << endl;
+		clearSurrogate();
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
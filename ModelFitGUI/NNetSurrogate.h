@@ -0,0 +1,119 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NNetSurrogate class
+//
+// Author: Jason Jenkins
+//
+// This class is a fast piecewise polynomial approximation of a 
+// trained neural network with a single input and a single output.
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////
+
+#include "NeuralNet.h"
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class is a fast piecewise polynomial approximation of a 
+/// trained neural network with a single input and a single output.
+/// </summary>
+/// 
+class NNetSurrogate
+{
+public:
+	NNetSurrogate();
+	virtual ~NNetSurrogate();
+
+	// constructs a NNetSurrogate object from a file
+	NNetSurrogate(const string& fName);
+
+	// clears a NNetSurrogate object ready for re-use
+	void clearSurrogate();
+
+	// builds the approximation of the given network over the given range
+	int build(const NeuralNet& net, double xMin, double xMax, double tolerance,
+			  int degree = 8, int maxSegments = 4096);
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the lower limit of the approximated range</returns>
+	double getMinX() const { return mMinX; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the upper limit of the approximated range</returns>
+	double getMaxX() const { return mMaxX; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the degree of the polynomial used for each segment</returns>
+	int getDegree() const { return mDegree; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of segments the range is divided into</returns>
+	int getNumSegments() const { return mNumSegments; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the largest error measured against the network</returns>
+	double getMaxError() const { return mMaxError; }
+
+	// gets the approximate network response to the given input
+	double getResponse(double x) const;
+
+	// serializes the approximation and writes it to a file
+	int writeToFile(const string& fname);
+
+private:
+	// fits the segment polynomials using the network responses
+	void fitSegments(const NNetFrozen& net);
+
+	// measures the largest error between the approximation and the network
+	double measureError(const NNetFrozen& net) const;
+
+	// generates a string representation of the approximation
+	string serialize();
+
+	// instantiates the approximation from a string representation
+	void deserialize(const string& inData);
+
+private:
+	/// <summary>the lower limit of the approximated range</summary>
+	double mMinX;
+
+	/// <summary>the upper limit of the approximated range</summary>
+	double mMaxX;
+
+	/// <summary>the number of segments per unit of x</summary>
+	double mScale;
+
+	/// <summary>the degree of the polynomial used for each segment</summary>
+	int mDegree;
+
+	/// <summary>the number of segments the range is divided into</summary>
+	int mNumSegments;
+
+	/// <summary>the largest error measured against the network</summary>
+	double mMaxError;
+
+	/// <summary>
+	/// the Chebyshev coefficients of each segment polynomial - (mDegree + 1)
+	/// coefficients per segment stored one segment after another
+	/// </summary>
+	vector<double> mCoeffs;
+};
+
+/////////////////////////////////////////////////////////////////////
@@ -1,680 +1,1262 @@
-/////////////////////////////////////////////////////////////////////
-//
-// Implements the NNetTrainer class
-//
-// Author: Jason Jenkins
-//
-// This class provides a framework for training a neural network.
-//
-// Once a network has been built it can then be trained using a
-// suitable set of input and output values - known as the training 
-// set.  Typically this set of values is quite large and for each 
-// input element there is a corresponding output or target element.
-// The training set input values are the inputs into the neural 
-// network and the corresponding target values represents the 
-// output that you would like the network to reproduce in response 
-// to the given input.
-// 
-// As an example: if the network has three input units and two output
-// units then each input element of the training set will have three 
-// values (stored in a three element vector) and each target element 
-// of the training set will have two values (stored in a two element
-// vector).
-//
-// The calling process of this trainer must first add a suitable 
-// training set consisting of the input and output values using the 
-// addNewTrainingSet method. The training parameters - the learning 
-// constant and the momentum - can then be optionally set using the 
-// setLearningConstant and setMomentum methods respectively. If these
-// parameters are not set then default values will be used instead. 
-// The training routine can then be called by passing the neural 
-// network that has been built with the required architecture to the
-// trainNeuralNet method which will carry out the training. The 
-// following code outlines this process:
-/*
-    // create the trainer
-    NNetTrainer trainer;
-
-    // the training set needs to be stored as follows
-    vector<vector<double> > inputVectors;
-    vector<vector<double> > targetVectors;
-
-    // a routine to populate the training set is required ...
-
-    // initialize the trainer
-    trainer.addNewTrainingSet(inputVectors, targetVectors);
-    trainer.setLearningConstant(0.05);
-    trainer.setMomentum(0.25);	
-
-    // train the network - here Net is the prior built network
-    trainer.trainNeuralNet(Net);
-
-    // inspect the total network error
-    double netError = trainer.getNetError();
-
-    // if more training is required then reset the network error
-    trainer.resetNetError();
-
-    // and call the training routine again
-    trainer.trainNeuralNet(net);
-	netError = trainer.getNetError();
-
-	// and repeat until training is complete
-*/
-//
-// The training routine feeds the first input vector of the training
-// set into the network. The output of the network - known as the 
-// response - is calculated and compared to the ideal output in the 
-// corresponding target vector of the training set. The difference 
-// between the response and target values - known as error - is 
-// calculated. The error value is then fed back through the network 
-// using a procedure called Backpropagation - the Wikipedia entry 
-// for this process can be found here:
-//
-//         https://en.wikipedia.org/wiki/Backpropagation. 
-//
-// The weighted connections linking the layers of the network 
-// together (initially set to random values) are adjusted by this
-// process using the gradient descent method to minimize the error. 
-// The next input element of the training set is then fed into the 
-// network and the response and associated error are calculated 
-// again and used to further adjust the weighted connections. This
-// process is continued until all the training set has been fed into
-// the network and the errors occurring at each step are totalled
-// together to give the total network error.
-//
-// The calling process of the trainer can then interrogate this 
-// value and if the total network error is found to be less than a
-// given predetermined value the training is deemed complete. But if
-// the total error is still above the predetermined value the network
-// error can be reset to zero and the training process can be called
-// again and again until the total error has reached the desired 
-// level or a set number of iterations has been exceeded.
-//
-/////////////////////////////////////////////////////////////////////
-
-#include "NNetTrainer.h"
-
-/////////////////////////////////////////////////////////////////////
-
-#include <math.h>
-#include <algorithm>
-#include <iostream>
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// default constructor
-/// </summary>
-/// 
-NNetTrainer::NNetTrainer()
-{
-	mNetError = 0;
-
-	// the default learning constant and momentum
-	mLearnConst = 0.5;
-	mMomentum = 0;
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// destructor
-/// </summary>
-///
-NNetTrainer::~NNetTrainer()
-{
-}
-
-/////////////////////////////////////////////////////////////////////
-// Public Methods
-/////////////////////////////////////////////////////////////////////
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// sets the learning constant training parameter - 
-/// 
-/// The learning constant governs the 'size' of the steps taken down
-/// the error surface. Larger values decrease training time but can
-/// lead to the system overshooting the minimum value.
-/// </summary>
-/// <param name="learnConst">the learning constant value</param>
-///
-void NNetTrainer::setLearningConstant(double learnConst)
-{ 
-	// ignore invalid values
-	if(learnConst > 0)
-	{
-		mLearnConst = learnConst;
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// sets the momentum training parameter - 
-/// 
-/// This term can be used to weight the search of the error surface
-/// to continue along the same 'direction' as the previous step.
-/// 
-/// A value of 1 will add 100% of the previous weighted connection
-/// value to the next weighted connection adjustment.  If set to 
-/// zero (the default value) the next step of the search will always
-/// proceed down the steepest path of the error surface.
-/// </summary>
-/// <param name="momentum">the momentum value</param>
-/// 
-void NNetTrainer::setMomentum(double momentum)
-{
-	// ignore invalid values
-	if(momentum > 0)
-	{
-		mMomentum = momentum;
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// trains the supplied neural network - 
-/// 
-/// Each time this method is called the order of the training set
-/// elements are randomly shuffled to try and avoid any potential
-/// bias toward certain patterns that may occur if the data
-/// were always presented to the trainer in the same order.
-/// </summary>
-/// <param name="nNet">the neural network to be trained</param>
-/// 
-void NNetTrainer::trainNeuralNet(NeuralNet& nNet)
-{	
-	int nTrain = (int)mTrainInput.size();
-	
-	vector<int> idx;
-
-	// populate the index list for the training set
-	for(int i = 0; i < nTrain; i++)
-	{
-		idx.push_back(i);
-	}
-
-	if(nTrain > 0)
-	{
-		// randomly shuffle the index list
-		std::random_shuffle(idx.begin(), idx.end());
-
-		for(int i = 0; i < nTrain; i++)
-		{
-			int index = idx[i];
-			vector<double> outVec;              // the network output values
-			vector<double> outErrSig;           // the output layer errors
-			vector<vector<double> > hidErrSig;  // the hidden layer errors
-
-			// get the next input values vector from the training set
-			vector<double> trainVec = mTrainInput[index];
-
-			// calculate the response from the training set input vector
-			nNet.getResponse(trainVec, outVec);
-
-			// calculate the total network error
-			mNetError += calcNetworkError(outVec, index);
-
-			// calculate the error signal on each output unit
-			calcOutputError(nNet, outErrSig, outVec, index);
-
-			// calculate the error signal on each hidden unit
-			calcHiddenError(hidErrSig, outErrSig, nNet);
-
-			// calculate the weight adjustments for the connections into the output layer
-			calcOutputWtAdjust(outErrSig, nNet);
-
-			// calculate the weight adjustments for the connections into the hidden layers
-			calcHiddenWtAdjust(hidErrSig, trainVec, nNet);
-		}
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// adds an individual input vector and the corresponding target 
-/// vector to the training set
-/// </summary>
-/// <param name="inVec">the input vector values</param>
-/// <param name="outVec">the corresponding target vector values</param>
-/// 
-void NNetTrainer::addToTrainingSet(const vector<double>& inVec,
-								   const vector<double>& outVec)
-{
-	mTrainInput.push_back(inVec);
-	mTrainTarget.push_back(outVec);
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// adds a complete training set of input and corresponding target 
-/// vectors to the trainer - 
-/// 
-/// A single input element of the training set consists of a vector of
-/// values hence the complete set of input values consists of a vector 
-/// of vectors. The complete target set is similarly defined.
-/// </summary>
-/// <param name="inVecs">a vector of input vector values</param>
-/// <param name="outVecs">a vector of corresponding target vector values</param>
-/// 
-void NNetTrainer::addNewTrainingSet(const vector<vector<double> >& inVecs, 
-									const vector<vector<double> >& outVecs)
-{
-	mTrainInput.clear();
-	mTrainTarget.clear();
-
-	mTrainInput = inVecs;
-	mTrainTarget = outVecs;
-}
-
-/////////////////////////////////////////////////////////////////////
-// Private Methods
-/////////////////////////////////////////////////////////////////////
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// calculates the network error between a given vector of response 
-/// values and the corresponding vector of target values
-/// </summary>
-/// <param name="response">the network response values</param>
-/// <param name="nTarget">the index of the corresponding target 
-///                       values in the training set</param>
-///
-/// <returns>the current network error value</returns>
-/// 
-double NNetTrainer::calcNetworkError(const vector<double>& response, int nTarget)
-{
-	double error = 0;
-	vector<double> targetVec = mTrainTarget[nTarget];
-
-	for(int i = 0; i < (int)response.size(); i++)
-	{
-		error += 0.5 * pow((targetVec[i] - response[i]), 2);
-	}
-
-	return error;
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// calculates the error signal on each individual unit in the output layer - 
-/// 
-/// Uses the gradient descent method to search the error surface.
-/// </summary>
-/// <param name="nNet">the network undergoing training</param>
-/// <param name="outErr">the calculated output unit errors</param>
-/// <param name="response">the network response values</param>
-/// <param name="nTarget">the index of the corresponding target values
-///                       in the training set</param>
-/// 
-void NNetTrainer::calcOutputError(NeuralNet& nNet, vector<double>& outErr,
-								  const vector<double>& response, int nTarget)
-{
-	vector<double> unitInputs, targetVec = mTrainTarget[nTarget];
-	
-	// get the output layer activation unit details
-	ActiveT outType = nNet.getOutputUnitType();
-	double outSlope = nNet.getOutputUnitSlope();
-	double outAmplify = nNet.getOutputUnitAmplify();
-
-	// get the output layer activation unit input values
-	nNet.getUnitInputs(unitInputs, nNet.getNumLayers());
-
-	for(int i = 0; i < (int)response.size(); i++)
-	{
-		double yi = response[i];
-		double xi = unitInputs[i];
-
-		// follow the steepest path on the error function by moving along the gradient
-		// of the output units activation function - the gradient descent method
-		double err = (targetVec[i] - yi) * getGradient(outType, outSlope, outAmplify, xi);
-
-		outErr.push_back(err);
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// calculates the error signal on each individual unit within the 
-/// networks hidden layers - 
-/// 
-/// Uses the gradient descent method to search the error surface.
-/// </summary>
-/// <param name="hidErr">the calculated hidden unit errors</param>
-/// <param name="outErr">the output unit errors</param>
-/// <param name="nNet">the network undergoing training</param>
-/// 
-void NNetTrainer::calcHiddenError(vector<vector<double> >& hidErr, 
-	                              const vector<double>& outErr, NeuralNet& nNet)
-{
-	ActiveT unitType;
-	double slope, amplify;
-	int nHidden = nNet.getNumLayers();
-
-	// initialise the the previous layer error with the output layer errors
-	vector<double> prevErr = outErr;
-
-	// start with the last hidden layer and work back to the first
-	for(int i = nHidden; i >= 1; i--)
-	{
-		vector<double> unitInputs, activations, layerErr;
-
-		// get the weighted connections for the current hidden layer
-		NNetWeightedConnect wtConnect;		
-		nNet.getWeightedConnect(wtConnect, i);
-		int nUnits = wtConnect.getNumInputNodes();
-		int nConnect = wtConnect.getNumOutputNodes();
-				
-		// get the hidden layer activation unit details
-		nNet.getLayerDetails(i - 1, unitType, slope, amplify);
-
-		// get the hidden layer activation unit input values
-		nNet.getUnitInputs(unitInputs, i - 1);
-
-		// calculate the hidden layer errors
-		for(int j = 0; j < nUnits; j++)
-		{
-			double error = 0;
-			double xj = unitInputs[j];
-			
-			for(int k = 0; k < nConnect; k++)
-			{
-				vector<double> weights;
-				wtConnect.getWeightVector(k, weights);
-
-				// follow the steepest path on the error function by moving along the gradient
-				// of the hidden layer units activation function - the gradient descent method
-				error += getGradient(unitType, slope, amplify, xj) * prevErr[k] * weights[j];
-			}
-
-			layerErr.push_back(error);
-		}
-
-		// update the hidden errors with the current layer error
-		// N.B. Since we start from the last hidden layer the 
-		// hidden layer error signals are stored in reverse order
-		hidErr.push_back(layerErr);
-
-		// back propagate the layer errors
-		prevErr.clear();
-		prevErr = layerErr;
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// calculates the weight adjustments for the connections into the 
-/// output layer
-/// </summary>
-/// <param name="outErr">the output unit errors</param>
-/// <param name="nNet">the network undergoing training</param>
-/// 
-void NNetTrainer::calcOutputWtAdjust(const vector<double>& outErr, NeuralNet& nNet)
-{
-	vector<double> xVec;
-	int n = nNet.getNumLayers(), prevIdx = 0;
-
-	// get the weighted connections between the last hidden layer and the output layer
-	NNetWeightedConnect wtConnect;		
-	nNet.getWeightedConnect(wtConnect, n);
-	
-	// get the input values for the weighted connections
-	nNet.getActivations(xVec, n - 1);
-
-	int nOut = wtConnect.getNumOutputNodes();
-
-	// calculate the weight adjustments for each weighted connection output unit
-	for(int i = 0; i < nOut; i++)
-	{
-		double ei = outErr[i];
-		vector<double> weights;
-
-		// get the output units weight vector
-		wtConnect.getWeightVector(i, weights);
-
-		// calculate the total weight adjustment
-		for(int j = 0; j < (int)xVec.size(); j++)
-		{
-			double dWPrev = 0;
-
-			// the weight adjustment calculation
-			double dW = mLearnConst * ei * xVec[j];
-
-			// if the momentum term is greater than 0
-			// the previous weighting needs to be taken into account
-			if(mMomentum > 0)
-			{
-				if((int)mPrevOutWt.size() > prevIdx)
-				{
-					dWPrev = mPrevOutWt[prevIdx];
-					
-					// include a percentage of the previous weighting
-					dW += mMomentum * dWPrev;
-					
-					// store the weighting 
-					mPrevOutWt[prevIdx] = dW;
-				}
-				else
-				{
-					// store the first weighting
-					mPrevOutWt.push_back(dW);
-				}
-			}
-
-			// the total weight adjustment
-			weights[j] += dW;
-			prevIdx++;
-		}
-
-		wtConnect.setWeightVector(i, weights);
-	}
-
-	nNet.setWeightedConnect(wtConnect, n);
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// calculates the weight adjustments for the connections into the 
-/// hidden layers
-/// </summary>
-/// <param name="hidErrSig">the hidden unit errors</param>
-/// <param name="inputVec">the current training set input values</param>
-/// <param name="nNet">the network undergoing training</param>
-/// 
-void NNetTrainer::calcHiddenWtAdjust(const vector<vector<double> >& hidErrSig,
-									 const vector<double>& inputVec, NeuralNet& nNet)
-{
-	vector<double> xVec;
-	int maxHidLayIdx = nNet.getNumLayers() - 1, prevIdx = 0;
-
-	// calculate the weight adjustments for the hidden layers
-	for(int n = maxHidLayIdx; n >= 0; n--)
-	{
-		// get the weighted connections between the current layer and the previous hidden layer
-		NNetWeightedConnect wtConnect;		
-		nNet.getWeightedConnect(wtConnect, n);
-		
-		// get the hidden unit errors for the previous hidden layer
-		// N.B. the hidden error signals are stored in reverse order
-		vector<double> outErr = hidErrSig[maxHidLayIdx - n];
-
-		if(n == 0)
-		{
-			// we are dealing with the input layer
-			xVec = inputVec;
-		}
-		else
-		{
-			// we are dealing with a hidden layer
-			nNet.getActivations(xVec, n - 1);
-		}
-
-		int nOut = wtConnect.getNumOutputNodes();
-
-		// calculate the weight adjustments for each weighted connection output unit
-		for(int i = 0; i < nOut; i++)
-		{
-			double ei = outErr[i];
-			vector<double> weights;
-			
-			// get the output units weight vector
-			wtConnect.getWeightVector(i, weights);
-
-			// calculate the total weight adjustment
-			for(int j = 0; j < (int)xVec.size(); j++)
-			{
-				double dWPrev = 0;
-
-				// the weight adjustment calculation
-				double dW = mLearnConst * ei * xVec[j];
-
-				// if the momentum term is greater than 0
-				// the previous weighting needs to be taken into account
-				if(mMomentum > 0)
-				{
-					if((int)mPrevHidWt.size() > prevIdx)
-					{
-						dWPrev = mPrevHidWt[prevIdx];
-
-						// include a percentage of the previous weighting
-						dW += mMomentum * dWPrev;
-						
-						// store the weighting 
-						mPrevHidWt[prevIdx] = dW;
-					}
-					else
-					{
-						// store the first weighting
-						mPrevHidWt.push_back(dW);
-					}
-				}
-
-				// the total weight adjustment
-				weights[j] += dW;
-				prevIdx++;
-			}
-
-			wtConnect.setWeightVector(i, weights);
-		}
-
-		nNet.setWeightedConnect(wtConnect, n);
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// gets the gradient of the activation function at the given value of x
-/// </summary>
-/// <param name="unitType">the activation function type</param>
-/// <param name="slope">the activation function slope value</param>
-/// <param name="amplify">the activation function amplify value</param>
-/// <param name="x">calculates the gradient at this value</param>
-///
-/// <returns>the gradient of the activation function at the given value</returns>
-/// 
-double NNetTrainer::getGradient(ActiveT unitType, double slope, double amplify, double x)
-{
-	double gradient = 0;	
-	double expMX, expMX1, tanMX, absMX1, grad;
-
-	switch(unitType)
-	{
-	case kThreshold:    // 0 everywhere except the origin where the derivative is undefined!
-
-		// return the value of the slope parameter if x = 0
-		if(x == 0) gradient = slope;
-		break;
-
-	case kUnipolar:
-
-		expMX = exp(-slope * x);
-		expMX1 = 1 + expMX;
-
-		gradient = (slope * expMX) / (expMX1 * expMX1);
-		break;
-
-	case kBipolar:
-
-		expMX = exp(-slope * x);
-		expMX1 = 1 + expMX;
-
-		gradient = (2 * slope * expMX) / (expMX1 * expMX1);
-		break;
-
-	case kTanh:
-
-		tanMX = tanh(slope * x);
-
-		gradient = slope * (1 - (tanMX * tanMX));
-		break;
-
-	case kGauss:
-
-		gradient = -2 * slope * x * exp(-slope * x * x);
-		break;
-
-	case kArctan:
-
-		gradient = slope / (1 + slope * slope * x * x);
-		break;
-
-	case kSin:
-
-		gradient = slope * cos(slope * x);
-		break;
-
-	case kCos:
-
-		gradient = -slope * sin(slope * x);
-		break;
-
-	case kSinC:
-		
-		if(fabs(x) < 0.00001)
-		{
-			gradient = 0;
-		}
-		else
-		{
-			gradient = (slope * x * cos(slope * x) - sin(slope * x)) / (slope * x * x);
-		}
-
-		break;
-
-	case kElliot:
-
-		absMX1 = 1 + fabs(slope * x);
-
-		gradient = (0.5 * slope) / (absMX1 * absMX1);
-		break;
-
-	case kLinear:
-
-		gradient = slope;
-		break;
-
-	case kISRU:
-
-		grad = 1 / sqrt(1 + slope * x * x);
-		
-		gradient = grad * grad * grad;
-		break;
-
-	case kSoftSign:
-
-		absMX1 = 1 + fabs(slope * x);
-
-		gradient = slope / (absMX1 * absMX1);
-		break;
-
-	case kSoftPlus:	
-
-		expMX = exp(slope * x);
-
-		gradient = (slope * expMX) / (1 + expMX);
-		break;
-	}
-
-	return amplify * gradient;
-}
-
-/////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////
+//
+// Implements the NNetTrainer class
+//
+// Author: Jason Jenkins
+//
+// This class provides a framework for training a neural network.
+//
+// Once a network has been built it can then be trained using a
+// suitable set of input and output values - known as the training 
+// set.  Typically this set of values is quite large and for each 
+// input element there is a corresponding output or target element.
+// The training set input values are the inputs into the neural 
+// network and the corresponding target values represents the 
+// output that you would like the network to reproduce in response 
+// to the given input.
+// 
+// As an example: if the network has three input units and two output
+// units then each input element of the training set will have three 
+// values (stored in a three element vector) and each target element 
+// of the training set will have two values (stored in a two element
+// vector).
+//
+// The calling process of this trainer must first add a suitable 
+// training set consisting of the input and output values using the 
+// addNewTrainingSet method. The training parameters - the learning 
+// constant and the momentum - can then be optionally set using the 
+// setLearningConstant and setMomentum methods respectively. If these
+// parameters are not set then default values will be used instead. 
+// The training routine can then be called by passing the neural 
+// network that has been built with the required architecture to the
+// trainNeuralNet method which will carry out the training. The 
+// following code outlines this process:
+/*
+    // create the trainer
+    NNetTrainer trainer;
+
+    // the training set needs to be stored as follows
+    vector<vector<double> > inputVectors;
+    vector<vector<double> > targetVectors;
+
+    // a routine to populate the training set is required ...
+
+    // initialize the trainer
+    trainer.addNewTrainingSet(inputVectors, targetVectors);
+    trainer.setLearningConstant(0.05);
+    trainer.setMomentum(0.25);	
+
+    // train the network - here Net is the prior built network
+    trainer.trainNeuralNet(Net);
+
+    // inspect the total network error
+    double netError = trainer.getNetError();
+
+    // if more training is required then reset the network error
+    trainer.resetNetError();
+
+    // and call the training routine again
+    trainer.trainNeuralNet(net);
+	netError = trainer.getNetError();
+
+	// and repeat until training is complete
+*/
+//
+// The training routine feeds the first input vector of the training
+// set into the network. The output of the network - known as the 
+// response - is calculated and compared to the ideal output in the 
+// corresponding target vector of the training set. The difference 
+// between the response and target values - known as error - is 
+// calculated. The error value is then fed back through the network 
+// using a procedure called Backpropagation - the Wikipedia entry 
+// for this process can be found here:
+//
+//         https://en.wikipedia.org/wiki/Backpropagation. 
+//
+// The weighted connections linking the layers of the network 
+// together (initially set to random values) are adjusted by this
+// process using the gradient descent method to minimize the error. 
+// The next input element of the training set is then fed into the 
+// network and the response and associated error are calculated 
+// again and used to further adjust the weighted connections. This
+// process is continued until all the training set has been fed into
+// the network and the errors occurring at each step are totalled
+// together to give the total network error.
+//
+// The calling process of the trainer can then interrogate this 
+// value and if the total network error is found to be less than a
+// given predetermined value the training is deemed complete. But if
+// the total error is still above the predetermined value the network
+// error can be reset to zero and the training process can be called
+// again and again until the total error has reached the desired 
+// level or a set number of iterations has been exceeded.
+//
+// The trainer counts the training passes and keeps track of the 
+// smallest network error reached at the end of a pass. The training
+// set is shuffled with the trainer's own random number generator, 
+// which can be seeded with setSeed, so a run can be repeated exactly.
+//
+// The network that reached the smallest error can also be kept. Only
+// the raw weights are copied - into a buffer that is reused each time
+// the error improves - and a single copy puts them back once the 
+// training is finished:
+/*
+    trainer.setKeepBestWeights(true);
+
+    for(int i = 0; i < numEpochs; i++)
+    {
+        trainer.trainNeuralNet(net);
+        trainer.resetNetError();
+    }
+
+    // use the network with the smallest error
+    trainer.restoreBestWeights(net);
+*/
+//
+// A long training run can be stopped and resumed later without any
+// change to its course. Everything the trainer carries from one pass
+// to the next - the previous weight adjustments used by the momentum
+// term, the training parameters, the pass counter, the minimum error
+// tracking (including any weights kept) and the state of the random 
+// number generator - is saved with writeStateToFile. The training set itself is not saved as it 
+// is rebuilt from the data. Together with a copy of the network the
+// training can then carry on exactly where it stopped:
+/*
+    // save the training state alongside the network
+    net.writeToBinaryFile("training.net");
+    trainer.writeStateToFile("training.state", net);
+
+    ...
+
+    // resume the training
+    NeuralNet net("training.net");
+    NNetTrainer trainer;
+
+    trainer.addNewTrainingSet(inputVectors, targetVectors);
+
+    if(trainer.readStateFromFile("training.state", net) == 0)
+    {
+        while(trainer.getEpoch() < numEpochs)
+        {
+            trainer.trainNeuralNet(net);
+            trainer.resetNetError();
+        }
+    }
+*/
+// The state is stored in binary form with a checksum - doubles are 
+// stored exactly as they are held (see NNetBinaryFormat.cpp):
+//
+//     tag        "NNETTRN\0"
+//     uint32     version, reserved
+//     double     learning constant, momentum
+//     int32      epoch, minimum error epoch
+//     double     network error, minimum network error
+//     uint64     random number generator state length (n)
+//     char[n]    random number generator state (in its text form)
+//     uint64     output and hidden momentum history lengths
+//     double[]   output layer momentum history
+//     double[]   hidden layer momentum history
+//     uint32     keep best weights flag, reserved       (version 2)
+//     uint64     best weights length                    (version 2)
+//     double[]   best weights                           (version 2)
+//     uint64     checksum of the network weights        (version 3)
+//     uint64     checksum of everything before it
+//
+// The state is only of use with the network it was saved with, so it 
+// records a checksum of the network's weights and a state is refused
+// if the network it is read for has different weights (for example a
+// state and network file left from different checkpoints).
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetTrainer.h"
+
+/////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include <float.h>
+#include <string.h>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetBinaryFormat.h"
+
+/////////////////////////////////////////////////////////////////////
+// Static Members
+/////////////////////////////////////////////////////////////////////
+
+const char NNetTrainer::kStateTag[8] = { 'N', 'N', 'E', 'T', 'T', 'R', 'N', '\0' };
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// default constructor
+/// </summary>
+/// 
+NNetTrainer::NNetTrainer()
+{
+	mNetError = 0;
+
+	// the default learning constant and momentum
+	mLearnConst = 0.5;
+	mMomentum = 0;
+
+	// no training passes yet
+	mEpoch = 0;
+	mMinNetError = DBL_MAX;
+	mMinErrorEpoch = 0;
+	mKeepBest = false;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// move constructor - the training set and momentum history are taken
+/// over rather than copied and are left empty in the other trainer
+/// </summary>
+/// <param name="other">the trainer whose training set and state are taken over</param>
+/// 
+NNetTrainer::NNetTrainer(NNetTrainer&& other) noexcept
+	: mNetError(other.mNetError), mLearnConst(other.mLearnConst), mMomentum(other.mMomentum),
+	  mEpoch(other.mEpoch), mMinNetError(other.mMinNetError), mMinErrorEpoch(other.mMinErrorEpoch),
+	  mRandom(other.mRandom), mKeepBest(other.mKeepBest), mBestWeights(move(other.mBestWeights)),
+	  mPrevOutWt(move(other.mPrevOutWt)), mPrevHidWt(move(other.mPrevHidWt)),
+	  mTrainInput(move(other.mTrainInput)), mTrainTarget(move(other.mTrainTarget))
+{
+	other.mBestWeights.clear();
+	other.mPrevOutWt.clear();
+	other.mPrevHidWt.clear();
+	other.mTrainInput.clear();
+	other.mTrainTarget.clear();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// destructor
+/// </summary>
+///
+NNetTrainer::~NNetTrainer()
+{
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// move assignment - the training set and momentum history are taken
+/// over rather than copied and are left empty in the other trainer
+/// </summary>
+/// <param name="other">the trainer whose training set and state are taken over</param>
+/// <returns>this trainer</returns>
+/// 
+NNetTrainer& NNetTrainer::operator=(NNetTrainer&& other) noexcept
+{
+	if(this != &other)
+	{
+		mNetError = other.mNetError;
+		mLearnConst = other.mLearnConst;
+		mMomentum = other.mMomentum;
+		mEpoch = other.mEpoch;
+		mMinNetError = other.mMinNetError;
+		mMinErrorEpoch = other.mMinErrorEpoch;
+		mRandom = other.mRandom;
+		mKeepBest = other.mKeepBest;
+
+		mBestWeights = move(other.mBestWeights);
+		mPrevOutWt = move(other.mPrevOutWt);
+		mPrevHidWt = move(other.mPrevHidWt);
+		mTrainInput = move(other.mTrainInput);
+		mTrainTarget = move(other.mTrainTarget);
+
+		other.mBestWeights.clear();
+		other.mPrevOutWt.clear();
+		other.mPrevHidWt.clear();
+		other.mTrainInput.clear();
+		other.mTrainTarget.clear();
+	}
+
+	return *this;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Public Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets the learning constant training parameter - 
+/// 
+/// The learning constant governs the 'size' of the steps taken down
+/// the error surface. Larger values decrease training time but can
+/// lead to the system overshooting the minimum value.
+/// </summary>
+/// <param name="learnConst">the learning constant value</param>
+///
+void NNetTrainer::setLearningConstant(double learnConst)
+{ 
+	// ignore invalid values
+	if(learnConst > 0)
+	{
+		mLearnConst = learnConst;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets the momentum training parameter - 
+/// 
+/// This term can be used to weight the search of the error surface
+/// to continue along the same 'direction' as the previous step.
+/// 
+/// A value of 1 will add 100% of the previous weighted connection
+/// value to the next weighted connection adjustment.  If set to 
+/// zero (the default value) the next step of the search will always
+/// proceed down the steepest path of the error surface.
+/// </summary>
+/// <param name="momentum">the momentum value</param>
+/// 
+void NNetTrainer::setMomentum(double momentum)
+{
+	// ignore invalid values
+	if(momentum > 0)
+	{
+		mMomentum = momentum;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// seeds the random number generator used to shuffle the training 
+/// set - the same seed gives the same sequence of training passes
+/// </summary>
+/// <param name="seed">the seed value</param>
+/// 
+void NNetTrainer::setSeed(unsigned int seed)
+{
+	mRandom.seed(seed);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets whether a copy of the weights is kept whenever the network 
+/// error reaches a new minimum - only the raw weights are copied (see
+/// NeuralNet::getWeights) into a buffer that is reused each time
+/// </summary>
+/// <param name="keepBest">true to keep the weights at the minimum network error</param>
+/// 
+void NNetTrainer::setKeepBestWeights(bool keepBest)
+{
+	mKeepBest = keepBest;
+
+	if(!mKeepBest)
+	{
+		mBestWeights.clear();
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// restores the network weights kept at the minimum network error -
+/// the weights are put back with a single copy
+/// </summary>
+/// <param name="nNet">the network being trained</param>
+/// <returns>0 if successful otherwise -1 (no weights are held or they do not match the network)</returns>
+/// 
+int NNetTrainer::restoreBestWeights(NeuralNet& nNet) const
+{
+	if(mBestWeights.empty())
+	{
+		return -1;
+	}
+
+	return nNet.setWeights(mBestWeights);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// trains the supplied neural network - 
+/// 
+/// Each time this method is called the order of the training set
+/// elements are randomly shuffled to try and avoid any potential
+/// bias toward certain patterns that may occur if the data
+/// were always presented to the trainer in the same order.
+/// 
+/// The pass is counted and the network error at the end of the pass
+/// is compared with the smallest so far - the weights are copied if 
+/// they are being kept and the error has improved.
+/// </summary>
+/// <param name="nNet">the neural network to be trained</param>
+/// 
+void NNetTrainer::trainNeuralNet(NeuralNet& nNet)
+{	
+	int nTrain = (int)mTrainInput.size();
+	
+	vector<int> idx;
+
+	// populate the index list for the training set
+	for(int i = 0; i < nTrain; i++)
+	{
+		idx.push_back(i);
+	}
+
+	if(nTrain > 0)
+	{
+		// randomly shuffle the index list
+		std::shuffle(idx.begin(), idx.end(), mRandom);
+
+		for(int i = 0; i < nTrain; i++)
+		{
+			int index = idx[i];
+			vector<double> outVec;              // the network output values
+			vector<double> outErrSig;           // the output layer errors
+			vector<vector<double> > hidErrSig;  // the hidden layer errors
+
+			// get the next input values vector from the training set
+			const vector<double>& trainVec = mTrainInput[index];
+
+			// calculate the response from the training set input vector
+			nNet.getResponse(trainVec, outVec);
+
+			// calculate the total network error
+			mNetError += calcNetworkError(outVec, index);
+
+			// calculate the error signal on each output unit
+			calcOutputError(nNet, outErrSig, outVec, index);
+
+			// calculate the error signal on each hidden unit
+			calcHiddenError(hidErrSig, outErrSig, nNet);
+
+			// calculate the weight adjustments for the connections into the output layer
+			calcOutputWtAdjust(outErrSig, nNet);
+
+			// calculate the weight adjustments for the connections into the hidden layers
+			calcHiddenWtAdjust(hidErrSig, trainVec, nNet);
+		}
+
+		mEpoch++;
+
+		// keep track of the minimum error value
+		if(mNetError < mMinNetError)
+		{
+			mMinNetError = mNetError;
+			mMinErrorEpoch = mEpoch;
+
+			if(mKeepBest)
+			{
+				nNet.getWeights(mBestWeights);
+			}
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// prunes the supplied neural network by removing the weighted 
+/// connections whose magnitude does not exceed a threshold - 
+/// 
+/// The pruned layers are stored in sparse form. The network can be
+/// fine-tuned afterwards by calling trainNeuralNet again - the pruned
+/// connections remain pruned. The record of the previous weight 
+/// adjustments kept for the momentum term is cleared as it no longer
+/// matches the connections, and the minimum network error tracking 
+/// (along with any weights kept) starts again.
+/// </summary>
+/// <param name="nNet">the neural network to be pruned</param>
+/// <param name="threshold">the pruning threshold (zero or more)</param>
+/// <returns>the number of remaining connections or -1 if the threshold is 
+/// negative or not a number (the network is then unchanged)</returns>
+/// 
+int NNetTrainer::pruneNeuralNet(NeuralNet& nNet, double threshold)
+{
+	int numConnections = 0;
+
+	// written so that a NaN threshold is rejected as well
+	if(!(threshold >= 0))
+	{
+		return -1;
+	}
+
+	for(int i = 0; i <= nNet.getNumLayers(); i++)	// use <= to include the output layer
+	{
+		numConnections += nNet.getWeightedConnect(i).pruneByThreshold(threshold);
+	}
+
+	// bring the smaller layers back together in the network's weight block
+	nNet.packWeights();
+
+	mPrevOutWt.clear();
+	mPrevHidWt.clear();
+	mBestWeights.clear();
+	mMinNetError = DBL_MAX;
+	mMinErrorEpoch = 0;
+
+	return numConnections;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// prunes the supplied neural network by keeping only the largest 
+/// weighted connections into each unit - 
+/// 
+/// As with pruneNeuralNet the network can be fine-tuned afterwards.
+/// </summary>
+/// <param name="nNet">the neural network to be pruned</param>
+/// <param name="numKept">the number of connections kept for each unit (zero or more)</param>
+/// <returns>the number of remaining connections or -1 if the number kept is 
+/// negative (the network is then unchanged)</returns>
+/// 
+int NNetTrainer::pruneNeuralNetTopK(NeuralNet& nNet, int numKept)
+{
+	int numConnections = 0;
+
+	if(numKept < 0)
+	{
+		return -1;
+	}
+
+	for(int i = 0; i <= nNet.getNumLayers(); i++)	// use <= to include the output layer
+	{
+		numConnections += nNet.getWeightedConnect(i).pruneByTopK(numKept);
+	}
+
+	// bring the smaller layers back together in the network's weight block
+	nNet.packWeights();
+
+	mPrevOutWt.clear();
+	mPrevHidWt.clear();
+	mBestWeights.clear();
+	mMinNetError = DBL_MAX;
+	mMinErrorEpoch = 0;
+
+	return numConnections;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// adds an individual input vector and the corresponding target 
+/// vector to the training set
+/// </summary>
+/// <param name="inVec">the input vector values</param>
+/// <param name="outVec">the corresponding target vector values</param>
+/// 
+void NNetTrainer::addToTrainingSet(const vector<double>& inVec,
+								   const vector<double>& outVec)
+{
+	mTrainInput.push_back(inVec);
+	mTrainTarget.push_back(outVec);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// adds an individual input vector and the corresponding target 
+/// vector to the training set - their storage is taken over by the
+/// trainer rather than copied
+/// </summary>
+/// <param name="inVec">the input vector values</param>
+/// <param name="outVec">the corresponding target vector values</param>
+/// 
+void NNetTrainer::addToTrainingSet(vector<double>&& inVec, vector<double>&& outVec)
+{
+	mTrainInput.push_back(move(inVec));
+	mTrainTarget.push_back(move(outVec));
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// adds a complete training set of input and corresponding target 
+/// vectors to the trainer - 
+/// 
+/// A single input element of the training set consists of a vector of
+/// values hence the complete set of input values consists of a vector 
+/// of vectors. The complete target set is similarly defined.
+/// </summary>
+/// <param name="inVecs">a vector of input vector values</param>
+/// <param name="outVecs">a vector of corresponding target vector values</param>
+/// 
+void NNetTrainer::addNewTrainingSet(const vector<vector<double> >& inVecs, 
+									const vector<vector<double> >& outVecs)
+{
+	mTrainInput.clear();
+	mTrainTarget.clear();
+
+	mTrainInput = inVecs;
+	mTrainTarget = outVecs;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// adds a complete training set of input and corresponding target 
+/// vectors to the trainer - the storage of the training set is taken
+/// over by the trainer rather than copied, which avoids duplicating a
+/// large training set
+/// </summary>
+/// <param name="inVecs">a vector of input vector values</param>
+/// <param name="outVecs">a vector of corresponding target vector values</param>
+/// 
+void NNetTrainer::addNewTrainingSet(vector<vector<double> >&& inVecs, 
+									vector<vector<double> >&& outVecs)
+{
+	mTrainInput = move(inVecs);
+	mTrainTarget = move(outVecs);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// writes the training state of a network to a file so the training
+/// can be resumed - see the top of this file for the layout
+/// </summary>
+/// <param name="fname">the file to write the data to</param>
+/// <param name="nNet">the network being trained</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NNetTrainer::writeStateToFile(const string& fname, const NeuralNet& nNet) const
+{
+	vector<char> data;
+
+	serializeState(data, nNet);
+
+	ofstream outFile(fname, ios::binary);
+
+	if(outFile.good())
+	{
+		outFile.write(data.data(), data.size());
+	}
+
+	return outFile.good() ? 0 : -1;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// restores the training state of a network from a file written by 
+/// writeStateToFile - the state is unchanged if the file can not be 
+/// read or was written for a network with different weights
+/// </summary>
+/// <param name="fname">the file containing the training state</param>
+/// <param name="nNet">the network being trained</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NNetTrainer::readStateFromFile(const string& fname, const NeuralNet& nNet)
+{
+	ifstream inFile(fname, ios::binary);
+	int result = -1;
+
+	if(inFile.good())
+	{
+		// find the length of the file
+		inFile.seekg(0, inFile.end);
+		int length = (int)inFile.tellg();
+		inFile.seekg(0, inFile.beg);
+
+		if(length > 0)
+		{
+			vector<char> buffer(length);
+
+			inFile.read(buffer.data(), length);
+
+			result = inFile.good() ? deserializeState(buffer.data(), length, nNet) : -1;
+
+			if(result != 0)
+			{
+				cerr << "Error deserializing!" << endl;
+			}
+		}
+	}
+
+	return result;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// generates a binary representation of the training state of a 
+/// network - see the top of this file for the layout
+/// </summary>
+/// <param name="outData">receives the binary representation</param>
+/// <param name="nNet">the network being trained</param>
+/// 
+void NNetTrainer::serializeState(vector<char>& outData, const NeuralNet& nNet) const
+{
+	unsigned int header[2] = { kStateVersion, 0 };
+	double params[2] = { mLearnConst, mMomentum };
+	int epochs[2] = { mEpoch, mMinErrorEpoch };
+	double errors[2] = { mNetError, mMinNetError };
+
+	// the generator state in its standard text form
+	ostringstream randomStream;
+
+	randomStream << mRandom;
+
+	string randomState = randomStream.str();
+	unsigned long long randomLength = randomState.size();
+	unsigned long long historyLengths[2] = { mPrevOutWt.size(), mPrevHidWt.size() };
+	unsigned int bestFlags[2] = { mKeepBest ? 1u : 0u, 0 };
+	unsigned long long bestLength = mBestWeights.size();
+	unsigned long long weightsChecksum = getWeightsChecksum(nNet);
+
+	// size the buffer up front so the momentum history is only copied once
+	outData.clear();
+	outData.reserve(sizeof(kStateTag) + sizeof(header) + sizeof(params) + sizeof(epochs) + sizeof(errors) +
+					sizeof(randomLength) + randomState.size() + sizeof(historyLengths) + sizeof(bestFlags) + sizeof(bestLength) +
+					sizeof(weightsChecksum) + sizeof(double) * (mPrevOutWt.size() + mPrevHidWt.size() + mBestWeights.size()) + 8);
+
+	NNetBinaryFormat::putValues(outData, kStateTag, 1, sizeof(kStateTag));
+	NNetBinaryFormat::putValues(outData, header, 4, 2);
+	NNetBinaryFormat::putValues(outData, params, 8, 2);
+	NNetBinaryFormat::putValues(outData, epochs, 4, 2);
+	NNetBinaryFormat::putValues(outData, errors, 8, 2);
+	NNetBinaryFormat::putValues(outData, &randomLength, 8, 1);
+	NNetBinaryFormat::putValues(outData, randomState.data(), 1, randomState.size());
+	NNetBinaryFormat::putValues(outData, historyLengths, 8, 2);
+	NNetBinaryFormat::putValues(outData, mPrevOutWt.data(), 8, mPrevOutWt.size());
+	NNetBinaryFormat::putValues(outData, mPrevHidWt.data(), 8, mPrevHidWt.size());
+	NNetBinaryFormat::putValues(outData, bestFlags, 4, 2);
+	NNetBinaryFormat::putValues(outData, &bestLength, 8, 1);
+	NNetBinaryFormat::putValues(outData, mBestWeights.data(), 8, mBestWeights.size());
+	NNetBinaryFormat::putValues(outData, &weightsChecksum, 8, 1);
+
+	// the checksum
+	unsigned long long checksum = NNetBinaryFormat::getChecksum(outData.data(), outData.size());
+
+	NNetBinaryFormat::putValues(outData, &checksum, 8, 1);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// restores the training state of a network from its binary 
+/// representation - the data is checked against its checksum and the
+/// state is unchanged if the data is damaged or inconsistent or was 
+/// generated for a network with different weights
+/// </summary>
+/// <param name="inData">the binary representation of the training state</param>
+/// <param name="length">the length of the binary representation</param>
+/// <param name="nNet">the network being trained</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NNetTrainer::deserializeState(const char* inData, size_t length, const NeuralNet& nNet)
+{
+	size_t pos = sizeof(kStateTag);
+	size_t checkPos = length - 8;
+	unsigned long long checksum = 0;
+
+	if(length < sizeof(kStateTag) + 8 || memcmp(inData, kStateTag, sizeof(kStateTag)) != 0)
+	{
+		return -1;
+	}
+
+	if(!NNetBinaryFormat::getValues(inData, length, checkPos, &checksum, 8, 1) ||
+	   checksum != NNetBinaryFormat::getChecksum(inData, length - 8))
+	{
+		return -1;
+	}
+
+	// the checksum is not part of the state
+	length -= 8;
+
+	unsigned int header[2];
+	double params[2];
+	int epochs[2];
+	double errors[2];
+	unsigned long long randomLength = 0;
+
+	if(!NNetBinaryFormat::getValues(inData, length, pos, header, 4, 2) || header[0] < 1 || header[0] > kStateVersion ||
+	   !NNetBinaryFormat::getValues(inData, length, pos, params, 8, 2) ||
+	   !NNetBinaryFormat::getValues(inData, length, pos, epochs, 4, 2) ||
+	   !NNetBinaryFormat::getValues(inData, length, pos, errors, 8, 2) ||
+	   !NNetBinaryFormat::getValues(inData, length, pos, &randomLength, 8, 1) ||
+	   randomLength > length - pos)
+	{
+		return -1;
+	}
+
+	if(params[0] <= 0 || params[1] < 0 || epochs[0] < 0 || epochs[1] < 0 || epochs[1] > epochs[0])
+	{
+		return -1;
+	}
+
+	// restore the generator from its text form
+	mt19937 random;
+	istringstream randomStream(string(inData + pos, (size_t)randomLength));
+
+	randomStream >> random;
+	pos += (size_t)randomLength;
+
+	if(randomStream.fail())
+	{
+		return -1;
+	}
+
+	unsigned long long historyLengths[2];
+
+	if(!NNetBinaryFormat::getValues(inData, length, pos, historyLengths, 8, 2) ||
+	   historyLengths[0] > (length - pos) / 8 || historyLengths[1] > (length - pos) / 8)
+	{
+		return -1;
+	}
+
+	vector<double> prevOutWt((size_t)historyLengths[0]);
+	vector<double> prevHidWt((size_t)historyLengths[1]);
+
+	if(!NNetBinaryFormat::getValues(inData, length, pos, prevOutWt.data(), 8, prevOutWt.size()) ||
+	   !NNetBinaryFormat::getValues(inData, length, pos, prevHidWt.data(), 8, prevHidWt.size()))
+	{
+		return -1;
+	}
+
+	// version 1 states do not keep the best weights
+	unsigned int bestFlags[2] = { 0, 0 };
+	unsigned long long bestLength = 0;
+	vector<double> bestWeights;
+
+	if(header[0] >= 2)
+	{
+		if(!NNetBinaryFormat::getValues(inData, length, pos, bestFlags, 4, 2) || bestFlags[0] > 1 ||
+		   !NNetBinaryFormat::getValues(inData, length, pos, &bestLength, 8, 1) ||
+		   bestLength > (length - pos) / 8)
+		{
+			return -1;
+		}
+
+		bestWeights.resize((size_t)bestLength);
+		NNetBinaryFormat::getValues(inData, length, pos, bestWeights.data(), 8, bestWeights.size());
+	}
+
+	// version 3 states can only be restored for the network they were generated for
+	if(header[0] >= 3)
+	{
+		unsigned long long weightsChecksum = 0;
+
+		if(!NNetBinaryFormat::getValues(inData, length, pos, &weightsChecksum, 8, 1) ||
+		   weightsChecksum != getWeightsChecksum(nNet))
+		{
+			return -1;
+		}
+	}
+
+	if(pos != length)
+	{
+		return -1;
+	}
+
+	// the state is valid
+	mLearnConst = params[0];
+	mMomentum = params[1];
+	mEpoch = epochs[0];
+	mMinErrorEpoch = epochs[1];
+	mNetError = errors[0];
+	mMinNetError = errors[1];
+	mRandom = random;
+	mPrevOutWt.swap(prevOutWt);
+	mPrevHidWt.swap(prevHidWt);
+	mKeepBest = (bestFlags[0] == 1);
+	mBestWeights.swap(bestWeights);
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Private Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// calculates the network error between a given vector of response 
+/// values and the corresponding vector of target values
+/// </summary>
+/// <param name="response">the network response values</param>
+/// <param name="nTarget">the index of the corresponding target 
+///                       values in the training set</param>
+///
+/// <returns>the current network error value</returns>
+/// 
+double NNetTrainer::calcNetworkError(const vector<double>& response, int nTarget)
+{
+	double error = 0;
+	const vector<double>& targetVec = mTrainTarget[nTarget];
+
+	for(int i = 0; i < (int)response.size(); i++)
+	{
+		error += 0.5 * pow((targetVec[i] - response[i]), 2);
+	}
+
+	return error;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// calculates the error signal on each individual unit in the output layer - 
+/// 
+/// Uses the gradient descent method to search the error surface.
+/// </summary>
+/// <param name="nNet">the network undergoing training</param>
+/// <param name="outErr">the calculated output unit errors</param>
+/// <param name="response">the network response values</param>
+/// <param name="nTarget">the index of the corresponding target values
+///                       in the training set</param>
+/// 
+void NNetTrainer::calcOutputError(NeuralNet& nNet, vector<double>& outErr,
+								  const vector<double>& response, int nTarget)
+{
+	const vector<double>& targetVec = mTrainTarget[nTarget];
+	
+	// get the output layer activation unit details
+	ActiveT outType = nNet.getOutputUnitType();
+	double outSlope = nNet.getOutputUnitSlope();
+	double outAmplify = nNet.getOutputUnitAmplify();
+
+	// get the output layer activation unit input values
+	const double* unitInputs = nNet.getUnitInputs(nNet.getNumLayers());
+
+	for(int i = 0; i < (int)response.size(); i++)
+	{
+		double yi = response[i];
+		double xi = unitInputs[i];
+
+		// follow the steepest path on the error function by moving along the gradient
+		// of the output units activation function - the gradient descent method
+		double err = (targetVec[i] - yi) * getGradient(outType, outSlope, outAmplify, xi);
+
+		outErr.push_back(err);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// calculates the error signal on each individual unit within the 
+/// networks hidden layers - 
+/// 
+/// Uses the gradient descent method to search the error surface.
+/// </summary>
+/// <param name="hidErr">the calculated hidden unit errors</param>
+/// <param name="outErr">the output unit errors</param>
+/// <param name="nNet">the network undergoing training</param>
+/// 
+void NNetTrainer::calcHiddenError(vector<vector<double> >& hidErr, 
+	                              const vector<double>& outErr, NeuralNet& nNet)
+{
+	ActiveT unitType;
+	double slope, amplify;
+	int nHidden = nNet.getNumLayers();
+
+	// initialise the the previous layer error with the output layer errors
+	vector<double> prevErr = outErr;
+
+	// start with the last hidden layer and work back to the first
+	for(int i = nHidden; i >= 1; i--)
+	{
+		vector<double> gradients;
+
+		// get the weighted connections for the current hidden layer
+		const NNetWeightedConnect& wtConnect = nNet.getWeightedConnect(i);
+		int nUnits = wtConnect.getNumInputNodes();
+				
+		// get the hidden layer activation unit details
+		nNet.getLayerDetails(i - 1, unitType, slope, amplify);
+
+		// get the hidden layer activation unit input values
+		const double* unitInputs = nNet.getUnitInputs(i - 1);
+
+		// follow the steepest path on the error function by moving along the gradient
+		// of the hidden layer units activation function - the gradient descent method
+		for(int j = 0; j < nUnits; j++)
+		{
+			gradients.push_back(getGradient(unitType, slope, amplify, unitInputs[j]));
+		}
+
+		// calculate the hidden layer errors - pruned connections are skipped
+		vector<double> layerErr(nUnits);
+
+		wtConnect.getInputErrors(prevErr.data(), gradients.data(), layerErr.data());
+
+		// back propagate the layer errors
+		prevErr = layerErr;
+
+		// update the hidden errors with the current layer error
+		// N.B. Since we start from the last hidden layer the 
+		// hidden layer error signals are stored in reverse order
+		hidErr.push_back(move(layerErr));
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// calculates the weight adjustments for the connections into the 
+/// output layer
+/// </summary>
+/// <param name="outErr">the output unit errors</param>
+/// <param name="nNet">the network undergoing training</param>
+/// 
+void NNetTrainer::calcOutputWtAdjust(const vector<double>& outErr, NeuralNet& nNet)
+{
+	int n = nNet.getNumLayers(), prevIdx = 0;
+
+	// get the weighted connections between the last hidden layer and the output layer
+	// N.B. the weights are updated in place
+	NNetWeightedConnect& wtConnect = nNet.getWeightedConnect(n);
+	
+	// get the input values for the weighted connections
+	const double* xVec = nNet.getActivations(n - 1);
+
+	int nOut = wtConnect.getNumOutputNodes();
+
+	// calculate the weight adjustments for each weighted connection output unit
+	for(int i = 0; i < nOut; i++)
+	{
+		double ei = outErr[i];
+		double* weights;
+		const int* inputNodes;
+
+		// get the output units weights - only the connections that have not been pruned
+		int nWeights = wtConnect.getRowWeights(i, weights, inputNodes);
+
+		// calculate the total weight adjustment
+		for(int j = 0; j < nWeights; j++)
+		{
+			double dWPrev = 0;
+
+			// the weight adjustment calculation
+			double dW = mLearnConst * ei * xVec[inputNodes ? inputNodes[j] : j];
+
+			// if the momentum term is greater than 0
+			// the previous weighting needs to be taken into account
+			if(mMomentum > 0)
+			{
+				if((int)mPrevOutWt.size() > prevIdx)
+				{
+					dWPrev = mPrevOutWt[prevIdx];
+					
+					// include a percentage of the previous weighting
+					dW += mMomentum * dWPrev;
+					
+					// store the weighting 
+					mPrevOutWt[prevIdx] = dW;
+				}
+				else
+				{
+					// store the first weighting
+					mPrevOutWt.push_back(dW);
+				}
+			}
+
+			// the total weight adjustment
+			weights[j] += dW;
+			prevIdx++;
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// calculates the weight adjustments for the connections into the 
+/// hidden layers
+/// </summary>
+/// <param name="hidErrSig">the hidden unit errors</param>
+/// <param name="inputVec">the current training set input values</param>
+/// <param name="nNet">the network undergoing training</param>
+/// 
+void NNetTrainer::calcHiddenWtAdjust(const vector<vector<double> >& hidErrSig,
+									 const vector<double>& inputVec, NeuralNet& nNet)
+{
+	int maxHidLayIdx = nNet.getNumLayers() - 1, prevIdx = 0;
+
+	// calculate the weight adjustments for the hidden layers
+	for(int n = maxHidLayIdx; n >= 0; n--)
+	{
+		// get the weighted connections between the current layer and the previous hidden layer
+		// N.B. the weights are updated in place
+		NNetWeightedConnect& wtConnect = nNet.getWeightedConnect(n);
+		
+		// get the hidden unit errors for the previous hidden layer
+		// N.B. the hidden error signals are stored in reverse order
+		const vector<double>& outErr = hidErrSig[maxHidLayIdx - n];
+
+		// the input values are the training set inputs for the first 
+		// hidden layer otherwise the previous hidden layer activations
+		const double* xVec = (n == 0) ? inputVec.data() : nNet.getActivations(n - 1);
+
+		int nOut = wtConnect.getNumOutputNodes();
+
+		// calculate the weight adjustments for each weighted connection output unit
+		for(int i = 0; i < nOut; i++)
+		{
+			double ei = outErr[i];
+			double* weights;
+			const int* inputNodes;
+			
+			// get the output units weights - only the connections that have not been pruned
+			int nWeights = wtConnect.getRowWeights(i, weights, inputNodes);
+
+			// calculate the total weight adjustment
+			for(int j = 0; j < nWeights; j++)
+			{
+				double dWPrev = 0;
+
+				// the weight adjustment calculation
+				double dW = mLearnConst * ei * xVec[inputNodes ? inputNodes[j] : j];
+
+				// if the momentum term is greater than 0
+				// the previous weighting needs to be taken into account
+				if(mMomentum > 0)
+				{
+					if((int)mPrevHidWt.size() > prevIdx)
+					{
+						dWPrev = mPrevHidWt[prevIdx];
+
+						// include a percentage of the previous weighting
+						dW += mMomentum * dWPrev;
+						
+						// store the weighting 
+						mPrevHidWt[prevIdx] = dW;
+					}
+					else
+					{
+						// store the first weighting
+						mPrevHidWt.push_back(dW);
+					}
+				}
+
+				// the total weight adjustment
+				weights[j] += dW;
+				prevIdx++;
+			}
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the gradient of the activation function at the given value of x
+/// </summary>
+/// <param name="unitType">the activation function type</param>
+/// <param name="slope">the activation function slope value</param>
+/// <param name="amplify">the activation function amplify value</param>
+/// <param name="x">calculates the gradient at this value</param>
+///
+/// <returns>the gradient of the activation function at the given value</returns>
+/// 
+double NNetTrainer::getGradient(ActiveT unitType, double slope, double amplify, double x)
+{
+	double gradient = 0;	
+	double expMX, expMX1, tanMX, absMX1, grad;
+
+	switch(unitType)
+	{
+	case kThreshold:    // 0 everywhere except the origin where the derivative is undefined!
+
+		// return the value of the slope parameter if x = 0
+		if(x == 0) gradient = slope;
+		break;
+
+	case kUnipolar:
+
+		expMX = exp(-slope * x);
+		expMX1 = 1 + expMX;
+
+		gradient = (slope * expMX) / (expMX1 * expMX1);
+		break;
+
+	case kBipolar:
+
+		expMX = exp(-slope * x);
+		expMX1 = 1 + expMX;
+
+		gradient = (2 * slope * expMX) / (expMX1 * expMX1);
+		break;
+
+	case kTanh:
+
+		tanMX = tanh(slope * x);
+
+		gradient = slope * (1 - (tanMX * tanMX));
+		break;
+
+	case kGauss:
+
+		gradient = -2 * slope * x * exp(-slope * x * x);
+		break;
+
+	case kArctan:
+
+		gradient = slope / (1 + slope * slope * x * x);
+		break;
+
+	case kSin:
+
+		gradient = slope * cos(slope * x);
+		break;
+
+	case kCos:
+
+		gradient = -slope * sin(slope * x);
+		break;
+
+	case kSinC:
+		
+		if(fabs(x) < 0.00001)
+		{
+			gradient = 0;
+		}
+		else
+		{
+			gradient = (slope * x * cos(slope * x) - sin(slope * x)) / (slope * x * x);
+		}
+
+		break;
+
+	case kElliot:
+
+		absMX1 = 1 + fabs(slope * x);
+
+		gradient = (0.5 * slope) / (absMX1 * absMX1);
+		break;
+
+	case kLinear:
+
+		gradient = slope;
+		break;
+
+	case kISRU:
+
+		grad = 1 / sqrt(1 + slope * x * x);
+		
+		gradient = grad * grad * grad;
+		break;
+
+	case kSoftSign:
+
+		absMX1 = 1 + fabs(slope * x);
+
+		gradient = slope / (absMX1 * absMX1);
+		break;
+
+	case kSoftPlus:	
+
+		expMX = exp(slope * x);
+
+		gradient = (slope * expMX) / (1 + expMX);
+		break;
+	}
+
+	return amplify * gradient;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// calculates the checksum of the weights of a network - the weights
+/// are taken in their little-endian form so the checksum is the same
+/// on every machine
+/// </summary>
+/// <param name="nNet">the network</param>
+/// <returns>the checksum</returns>
+/// 
+unsigned long long NNetTrainer::getWeightsChecksum(const NeuralNet& nNet)
+{
+	vector<double> weights;
+	vector<char> data;
+
+	nNet.getWeights(weights);
+	NNetBinaryFormat::putValues(data, weights.data(), 8, weights.size());
+
+	return NNetBinaryFormat::getChecksum(data.data(), data.size());
+}
+
+/////////////////////////////////////////////////////////////////////
@@ -1,113 +1,215 @@
-/////////////////////////////////////////////////////////////////////
-//
-// Defines the NNetTrainer class
-//
-// Author: Jason Jenkins
-//
-// This class provides a framework for training a neural network.
-//
-/////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-/////////////////////////////////////////////////////////////////////
-
-#include "NeuralNet.h"
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// This class provides a framework for training a neural network.
-/// </summary>
-/// 
-class NNetTrainer
-{
-public:
-	NNetTrainer();
-	virtual ~NNetTrainer();
-
-	// sets the learning constant training parameter
-	void setLearningConstant(double learnConst);
-
-	/// <summary>
-	/// <returns>the learning constant training parameter</returns>
-	/// </summary>
-	double getLearningConst() const { return mLearnConst; }
-
-	// sets the momentum training parameter
-	void setMomentum(double momentum);
-
-	/// <summary>
-	/// <returns>the momentum training parameter</returns>
-	/// </summary>
-	double getMomentum() const { return mMomentum; }
-
-	/// <summary>
-	/// <returns>the total network error</returns>
-	/// </summary>
-	double getNetError() const { return mNetError; }
-
-	/// <summary>
-	/// resets the total network error to zero
-	/// </summary>
-	void resetNetError() { mNetError = 0; }
-	
-	// trains the supplied neural network	
-	void trainNeuralNet(NeuralNet& nNet);
-
-	// adds an individual training vector and 
-	// corresponding target vector to the training set
-	void addToTrainingSet(const vector<double>& inVec, 
-						  const vector<double>& outVec);
-
-	// adds a complete set of training vectors and
-	// corresponding target vectors to the trainer
-	void addNewTrainingSet(const vector<vector<double> >& inVecs, 
-						   const vector<vector<double> >& outVecs);
-
-private:
-	// calculates the network error between a given vector of 
-	// response values and the corresponding vector of target values
-	double calcNetworkError(const vector<double>& response, int nTarget);
-
-	// calculates the error signal on each individual output unit in the output layer
-	void calcOutputError(NeuralNet& nNet, vector<double>& outErr,
-						 const vector<double>& response, int nTarget);
-	
-	// calculates the error signal on each individual unit within the networks hidden layers
-	void calcHiddenError(vector<vector<double> >& hidErr, 
-						 const vector<double>& outErr, NeuralNet& nNet);
-
-	// calculates the weight adjustments for the connections into the output layer
-	void calcOutputWtAdjust(const vector<double>& outErr, NeuralNet& nNet);
-
-	// calculates the weight adjustments for the connections into the hidden layers
-	void calcHiddenWtAdjust(const vector<vector<double> >& hidErrSig, 
-							const vector<double>& inputVec, NeuralNet& nNet);
-
-	// returns the gradient of the activation function at the given value
-	double getGradient(ActiveT unitType, double slope, double amplify, double x);
-
-private:
-	/// <summary>the network error</summary>
-	double mNetError;
-
-	/// <summary>the learning constant</summary>
-	double mLearnConst;
-
-	/// <summary>the momentum parameter</summary>
-	double mMomentum;
-
-	/// <summary>keeps track of the output layer weightings for use by the momentum term</summary>
-	vector<double> mPrevOutWt;
-
-	/// <summary>keeps track of the hidden layer weightings for use by the momentum term</summary>
-	vector<double> mPrevHidWt;
-
-	/// <summary>the training set input values</summary>
-	vector<vector<double> > mTrainInput;
-
-	/// <summary>the training set target values</summary>
-	vector<vector<double> > mTrainTarget;
-};
-
-/////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NNetTrainer class
+//
+// Author: Jason Jenkins
+//
+// This class provides a framework for training a neural network.
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <random>
+
+/////////////////////////////////////////////////////////////////////
+
+#include "NeuralNet.h"
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class provides a framework for training a neural network.
+/// </summary>
+/// 
+class NNetTrainer
+{
+public:
+	NNetTrainer();
+	virtual ~NNetTrainer();
+
+	NNetTrainer(const NNetTrainer& other) = default;
+	NNetTrainer& operator=(const NNetTrainer& other) = default;
+
+	// moves the training set and state of another trainer into a new trainer
+	NNetTrainer(NNetTrainer&& other) noexcept;
+
+	// moves the training set and state of another trainer into this trainer
+	NNetTrainer& operator=(NNetTrainer&& other) noexcept;
+
+	// sets the learning constant training parameter
+	void setLearningConstant(double learnConst);
+
+	/// <summary>
+	/// <returns>the learning constant training parameter</returns>
+	/// </summary>
+	double getLearningConst() const { return mLearnConst; }
+
+	// sets the momentum training parameter
+	void setMomentum(double momentum);
+
+	/// <summary>
+	/// <returns>the momentum training parameter</returns>
+	/// </summary>
+	double getMomentum() const { return mMomentum; }
+
+	/// <summary>
+	/// <returns>the total network error</returns>
+	/// </summary>
+	double getNetError() const { return mNetError; }
+
+	/// <summary>
+	/// resets the total network error to zero
+	/// </summary>
+	void resetNetError() { mNetError = 0; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of training passes completed</returns>
+	int getEpoch() const { return mEpoch; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the smallest network error at the end of a training pass</returns>
+	double getMinNetError() const { return mMinNetError; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the training pass that reached the smallest network error (0 if none)</returns>
+	int getMinErrorEpoch() const { return mMinErrorEpoch; }
+
+	// sets whether a copy of the weights is kept at the minimum network error
+	void setKeepBestWeights(bool keepBest);
+
+	/// <summary>
+	/// </summary>
+	/// <returns>true if a copy of the weights is kept at the minimum network error</returns>
+	bool getKeepBestWeights() const { return mKeepBest; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>true if a copy of the weights at the minimum network error is held</returns>
+	bool hasBestWeights() const { return !mBestWeights.empty(); }
+
+	// restores the network weights kept at the minimum network error
+	int restoreBestWeights(NeuralNet& nNet) const;
+
+	// seeds the random number generator used to shuffle the training set
+	void setSeed(unsigned int seed);
+	
+	// trains the supplied neural network	
+	void trainNeuralNet(NeuralNet& nNet);
+
+	// prunes the weighted connections whose magnitude does not exceed a threshold
+	int pruneNeuralNet(NeuralNet& nNet, double threshold);
+
+	// prunes all but the largest weighted connections into each unit
+	int pruneNeuralNetTopK(NeuralNet& nNet, int numKept);
+
+	// adds an individual training vector and 
+	// corresponding target vector to the training set
+	void addToTrainingSet(const vector<double>& inVec, 
+						  const vector<double>& outVec);
+
+	// adds an individual training vector and corresponding target 
+	// vector to the training set taking over their storage
+	void addToTrainingSet(vector<double>&& inVec, vector<double>&& outVec);
+
+	// adds a complete set of training vectors and
+	// corresponding target vectors to the trainer
+	void addNewTrainingSet(const vector<vector<double> >& inVecs, 
+						   const vector<vector<double> >& outVecs);
+
+	// adds a complete set of training vectors and corresponding 
+	// target vectors to the trainer taking over their storage
+	void addNewTrainingSet(vector<vector<double> >&& inVecs, 
+						   vector<vector<double> >&& outVecs);
+
+	// writes the training state of a network to a file so the training can be resumed
+	int writeStateToFile(const string& fname, const NeuralNet& nNet) const;
+
+	// restores the training state of a network from a file written by writeStateToFile
+	int readStateFromFile(const string& fname, const NeuralNet& nNet);
+
+	// generates a binary representation of the training state of a network
+	void serializeState(vector<char>& outData, const NeuralNet& nNet) const;
+
+	// restores the training state of a network from its binary representation
+	int deserializeState(const char* inData, size_t length, const NeuralNet& nNet);
+
+public:
+	/// <summary>the tag at the start of a training state file</summary>
+	static const char kStateTag[8];
+
+	/// <summary>the training state format version written by this class</summary>
+	static const unsigned int kStateVersion = 3;
+
+private:
+	// calculates the network error between a given vector of 
+	// response values and the corresponding vector of target values
+	double calcNetworkError(const vector<double>& response, int nTarget);
+
+	// calculates the error signal on each individual output unit in the output layer
+	void calcOutputError(NeuralNet& nNet, vector<double>& outErr,
+						 const vector<double>& response, int nTarget);
+	
+	// calculates the error signal on each individual unit within the networks hidden layers
+	void calcHiddenError(vector<vector<double> >& hidErr, 
+						 const vector<double>& outErr, NeuralNet& nNet);
+
+	// calculates the weight adjustments for the connections into the output layer
+	void calcOutputWtAdjust(const vector<double>& outErr, NeuralNet& nNet);
+
+	// calculates the weight adjustments for the connections into the hidden layers
+	void calcHiddenWtAdjust(const vector<vector<double> >& hidErrSig, 
+							const vector<double>& inputVec, NeuralNet& nNet);
+
+	// returns the gradient of the activation function at the given value
+	double getGradient(ActiveT unitType, double slope, double amplify, double x);
+
+	// calculates the checksum of the weights of a network
+	static unsigned long long getWeightsChecksum(const NeuralNet& nNet);
+
+private:
+	/// <summary>the network error</summary>
+	double mNetError;
+
+	/// <summary>the learning constant</summary>
+	double mLearnConst;
+
+	/// <summary>the momentum parameter</summary>
+	double mMomentum;
+
+	/// <summary>the number of training passes completed</summary>
+	int mEpoch;
+
+	/// <summary>the smallest network error at the end of a training pass</summary>
+	double mMinNetError;
+
+	/// <summary>the training pass that reached the smallest network error</summary>
+	int mMinErrorEpoch;
+
+	/// <summary>shuffles the training set before each training pass</summary>
+	mt19937 mRandom;
+
+	/// <summary>true if a copy of the weights is kept at the minimum network error</summary>
+	bool mKeepBest;
+
+	/// <summary>the weights of the network at the minimum network error (if kept)</summary>
+	vector<double> mBestWeights;
+
+	/// <summary>keeps track of the output layer weightings for use by the momentum term</summary>
+	vector<double> mPrevOutWt;
+
+	/// <summary>keeps track of the hidden layer weightings for use by the momentum term</summary>
+	vector<double> mPrevHidWt;
+
+	/// <summary>the training set input values</summary>
+	vector<vector<double> > mTrainInput;
+
+	/// <summary>the training set target values</summary>
+	vector<vector<double> > mTrainTarget;
+};
+
+/////////////////////////////////////////////////////////////////////
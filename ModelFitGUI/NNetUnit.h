@@ -1,71 +1,208 @@
-/////////////////////////////////////////////////////////////////////
-//
-// Defines the NNetUnit class
-//
-// Author: Jason Jenkins
-//
-// This class is used by the neural network class (NeuralNet) and
-// represents the basic neural network unit or neuron.
-//
-/////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-/////////////////////////////////////////////////////////////////////
-
-#include <string>
-
-/////////////////////////////////////////////////////////////////////
-/// The available activation functions as an enumerated type
-
-typedef enum { kThreshold, kUnipolar, kBipolar, kTanh, kGauss, kArctan, kSin,
-			   kCos, kSinC, kElliot, kLinear, kISRU, kSoftSign, kSoftPlus } ActiveT;
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// This class is used by the neural network class (NeuralNet) and
-/// represents the basic neural network unit or neuron.
-/// </summary>
-/// 
-class NNetUnit
-{
-public:
-	NNetUnit();
-	virtual ~NNetUnit();
-
-	// constructs a neuron with the given activation function and settings
-	NNetUnit(ActiveT activationMode, double slope = 1.0, double amplify = 1.0);
-	
-	/// <summary>sets the activation function type</summary>
-	void setActivationType(ActiveT activationType) { mActivationType = activationType; };
-
-	/// <summary>sets the input value of the neuron</summary>
-	void setInput(double input) { mInput = input; }
-
-	// sets the slope parameter of the activation function
-	void setSlope(double slope);
-
-	// sets the amplify parameter of the activation function
-	void setAmplify(double amplify);
-
-	// returns activation value of the neuron
-	double getActivation();
-
-	// converts an ActiveT enumeration to its string representation
-	static std::string ActiveTtoString(const ActiveT activEnum);
-
-private:
-	/// <summary>the unit activation function type</summary>
-	ActiveT mActivationType;
-
-	/// <summary>the unit input value</summary>
-	double mInput;
-
-	/// <summary>the activation function slope setting</summary>
-	double mSlope;
-
-	/// <summary>the activation function amplify setting</summary>
-	double mAmplify;
-};
-
-/////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NNetUnit class
+//
+// Author: Jason Jenkins
+//
+// This class is used by the neural network class (NeuralNet) and
+// represents the basic neural network unit or neuron.
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include <string>
+
+/////////////////////////////////////////////////////////////////////
+/// The available activation functions as an enumerated type
+
+typedef enum { kThreshold, kUnipolar, kBipolar, kTanh, kGauss, kArctan, kSin,
+			   kCos, kSinC, kElliot, kLinear, kISRU, kSoftSign, kSoftPlus } ActiveT;
+
+/////////////////////////////////////////////////////////////////////
+/// An activation kernel applies an activation function, with the given
+/// slope and amplify values, to an array of unit input values
+
+typedef void (*ActivationFn)(const double* inputs, double* outputs, int n, 
+							 double slope, double amplify);
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class is used by the neural network class (NeuralNet) and
+/// represents the basic neural network unit or neuron.
+/// </summary>
+/// 
+class NNetUnit
+{
+public:
+	NNetUnit();
+	virtual ~NNetUnit();
+
+	// constructs a neuron with the given activation function and settings
+	NNetUnit(ActiveT activationMode, double slope = 1.0, double amplify = 1.0);
+	
+	/// <summary>sets the activation function type</summary>
+	void setActivationType(ActiveT activationType) { mActivationType = activationType; };
+
+	/// <summary>sets the input value of the neuron</summary>
+	void setInput(double input) { mInput = input; }
+
+	// sets the slope parameter of the activation function
+	void setSlope(double slope);
+
+	// sets the amplify parameter of the activation function
+	void setAmplify(double amplify);
+
+	// returns activation value of the neuron
+	double getActivation();
+
+	// calculates the value of an activation function
+	static double calcActivation(ActiveT unitType, double slope, double amplify, double input);
+
+	// calculates the value of an activation function whose type is fixed at compile time
+	template<ActiveT unitType>
+	static double calcActivation(double slope, double amplify, double input);
+
+	// returns the activation kernel for the given activation function type
+	static ActivationFn getActivationFunction(ActiveT unitType);
+
+	// converts an ActiveT enumeration to its string representation
+	static std::string ActiveTtoString(const ActiveT activEnum);
+
+private:
+	/// <summary>the unit activation function type</summary>
+	ActiveT mActivationType;
+
+	/// <summary>the unit input value</summary>
+	double mInput;
+
+	/// <summary>the activation function slope setting</summary>
+	double mSlope;
+
+	/// <summary>the activation function amplify setting</summary>
+	double mAmplify;
+};
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// calculates the value of an activation function whose type is fixed
+/// at compile time - 
+/// 
+/// This is the single definition of the activation functions used by
+/// the neuron, the activation kernels and the fixed topology networks.
+/// It is defined here so callers that know the function type can 
+/// inline it, the switch is on a constant and reduces to one case.
+/// </summary>
+/// <param name="slope">the activation function slope value</param>
+/// <param name="amplify">the activation function amplify value</param>
+/// <param name="input">the unit input value</param>
+/// <returns>the activation value</returns>
+/// 
+template<ActiveT unitType>
+inline double NNetUnit::calcActivation(double slope, double amplify, double input)
+{
+	double activation = 0;
+
+	switch(unitType)
+	{
+	case kThreshold:    // default range: 0 OR slope
+                        // amplified range: 0 OR (slope * amplify)
+		if(input >= 0)
+		{
+			activation = 1 * slope;
+		}
+		break;
+
+	case kUnipolar:     // default range: 0 to 1
+                        // amplified range: 0 to amplify
+
+		activation = 1.0 / (1.0 + exp(-slope * input));
+		break;
+
+	case kBipolar:      // default range: -1 to 1
+                        // amplified range: -amplify to amplify
+
+		activation = (2.0 / (1.0 + exp(-slope * input))) - 1;
+		break;
+
+	case kTanh:         // default range: -1 to 1
+                        // amplified range: -amplify to amplify
+
+		activation = tanh(slope * input);
+		break;
+
+	case kGauss:        // default range: 0 to 1
+                        // amplified range: 0 to amplify
+
+		activation = exp(-slope * input * input);
+		break;
+
+	case kArctan:       // default range: -pi/2 to +pi/2
+                        // amplified range: -(pi/2) * amplify to +(pi/2) * amplify
+
+		activation = atan(slope * input);
+		break;
+
+	case kSin:          // default range: -1 to 1
+                        // amplified range: -amplify to amplify
+
+		activation = sin(slope * input);
+		break;
+
+	case kCos:          // default range: -1 to 1
+                        // amplified range: -amplify to +amplify
+
+		activation = cos(slope * input);
+		break;
+
+	case kSinC:         // default range: ~ -0.217234 to 1
+                        // amplified range: ~ -(amplify * 0.217234) to amplify
+
+		if(fabs(input) < 0.00001)
+		{
+			activation = 1.0;
+		}
+		else
+		{
+			activation = sin(slope * input) / (slope * input);
+		}
+
+		break;
+
+	case kElliot:       // default range: 0 to 1
+                        // amplified range: 0 to amplify
+
+		activation = ((slope * input) / 2) / (1 + fabs(slope * input)) + 0.5;
+		break;
+
+	case kLinear:       // range: -infinity to +infinity
+						
+		activation = slope * input;
+		break;
+
+	case kISRU:         // default range: -1 / sqrt(slope) to 1 / sqrt(slope)
+                        // amplified range: -(amplify / sqrt(slope)) to +(amplify / sqrt(slope))
+
+		activation = input / sqrt(1 + slope * input * input);
+		break;
+
+	case kSoftSign:		// default range: -1 to 1
+						// amplified range: -amplify to amplify
+
+		activation = (slope * input) / (1 + fabs(slope * input));
+		break;
+
+	case kSoftPlus:     // range: 0 to +infinity
+
+		activation = log(1 + exp(slope * input));
+		break;
+	}
+
+    // the activation value is increased if amplify > 1 or reduced if amplify < 1
+	return amplify * activation;
+}
+
+/////////////////////////////////////////////////////////////////////
@@ -1,289 +1,1124 @@
-/////////////////////////////////////////////////////////////////////
-//
-// Implements the NNetWeightedConnect class
-//
-// Author: Jason Jenkins
-//
-// This class is used by the neural network class (NeuralNet) and
-// represents the weighted connections that link the layers of a 
-// neural network together.
-//
-// The layers of a neural network are connected by a system of
-// weighted connections. Each unit in a given layer of the network
-// (excluding the output layer) has a single connection to every 
-// unit in the next layer. These connections are initially given
-// a random value which is then updated when the neural network
-// is trained.
-//
-// In this class the weighted connections between two layers 
-// consist of a given number of input and output nodes. If the
-// first layer of a network contains three units and the second
-// layer contains four to connect these layers together we require
-// a weighted connection with three input nodes and four output
-// nodes.
-//
-// Each input node is connected to every output node. The input 
-// nodes have their values set by the setInputs method and these
-// values represent the activated output of a particular layer
-// within the network. The value of a specific output node is the
-// result of applying the weighted connections between that output
-// node and all the connected input nodes - each input node value is
-// multiplied by the weighted connection between the input node and 
-// the given output node in turn and the results are then summed to 
-// give the output node value. The output node values can be obtained
-// via the getOutputs method and these values can then be used by the
-// network as the input values to the activation functions of the
-// next layer.
-//
-// The weights of the connections between a given output node and
-// the input nodes can be retrieved via the getWeightVector method
-// and set via the setWeightVector method. These two methods are 
-// typically called by the network training process.
-//
-/////////////////////////////////////////////////////////////////////
-
-#include "NNetWeightedConnect.h"
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// default constructor
-/// </summary>
-/// 
-NNetWeightedConnect::NNetWeightedConnect()
-{
-	// default connection settings
-	mNumInNodes = -1;
-	mNumOutNodes = -1;
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// constructs a connection between the given number of nodes
-/// </summary>
-/// <param name="numInNodes">the number of input nodes</param>
-/// <param name="numOutNodes">the number of output nodes</param>
-/// 
-NNetWeightedConnect::NNetWeightedConnect(int numInNodes, int numOutNodes)
-{
-	// ignore invalid data
-	if(numInNodes > 0 && numOutNodes > 0)
-	{
-		mNumInNodes = numInNodes;
-		mNumOutNodes = numOutNodes;
-
-		initialiseWeights();
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// destructor
-/// </summary>
-///
-NNetWeightedConnect::~NNetWeightedConnect()
-{
-}
-
-/////////////////////////////////////////////////////////////////////
-// Public Methods
-/////////////////////////////////////////////////////////////////////
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// sets the number of input and output nodes - 
-/// 
-/// The weighted connections are randomly initialised over the range
-/// -(initRange/2) to +(initRange/2).
-/// </summary>
-/// <param name="numInNodes">the number of input nodes</param>
-/// <param name="numOutNodes">the number of output nodes</param>
-/// <param name="initRange">the range used for random initialisation</param>
-/// 
-void NNetWeightedConnect::setNumNodes(int numInNodes, int numOutNodes, double initRange)
-{
-	// ignore invalid data
-	if(numInNodes > 0 && numOutNodes > 0 && initRange > 0)
-	{
-		mNumInNodes = numInNodes;
-		mNumOutNodes = numOutNodes;
-
-		initialiseWeights(initRange);
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// sets the input values for the weighted connection - 
-/// 
-/// The input value for the first input node is the first value stored
-/// in the list and the input value for the second input node is the
-/// second value stored in the list and so on.
-/// </summary>
-/// <param name="inputs">a vector of input values</param>
-/// 
-void NNetWeightedConnect::setInputs(const vector<double>& inputs)
-{
-	// make sure the size of the input vector corresponds to the number of input nodes
-	if((int)inputs.size() == mNumInNodes)
-	{
-		if(mInputs.empty())
-		{
-			mInputs.resize(mNumInNodes);
-		}
-
-		// copy will overwrite the original values
-		copy(inputs.begin(), inputs.end(), mInputs.begin());
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// gets the output values for the weighted connection - 
-/// 
-/// The output values are calculated by applying the weighted
-/// connections to the input node values.
-/// </summary>
-/// <param name="outputs">the output values</param>
-/// 
-void NNetWeightedConnect::getOutputs(vector<double>& outputs)
-{
-	// resize the output vector if necessary
-	if((int)outputs.size() != mNumOutNodes)
-	{
-		outputs.resize(mNumOutNodes);
-	}
-
-	calculateOutput();
-
-	copy(mOutputs.begin(), mOutputs.end(), outputs.begin());
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// gets the weighted connections vector for a given output node - 
-/// 
-/// This method is typically called when training the network.
-/// </summary>
-/// <param name="node">the index of the output node</param>
-/// <param name="weights">the weighted connections vector</param>
-/// 
-void NNetWeightedConnect::getWeightVector(int node, vector<double>& weights)
-{
-	if(node < (int)mWeights.size() && node >= 0)
-	{
-		vector<double> vecWeights = mWeights[node];
-
-		if(weights.size() != vecWeights.size())
-		{
-			weights.resize(vecWeights.size());
-		}
-
-		copy(vecWeights.begin(), vecWeights.end(), weights.begin());
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// sets the weighted connections vector for a given output node - 
-/// 
-/// This method is typically called by the training process to update the weighted connections.
-/// </summary>
-/// <param name="node">the index of the output node</param>
-/// <param name="weights">the weighted connections vector</param>
-/// 
-void NNetWeightedConnect::setWeightVector(int node, const vector<double>& weights)
-{
-	if(node < (int)mWeights.size() && node >= 0)
-	{
-		if(mWeights[node].size() == weights.size())
-		{
-			for(int i = 0; i < (int)weights.size(); i++)
-			{
-				mWeights[node][i] = weights[i];
-			}
-		}
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-// Private Methods
-/////////////////////////////////////////////////////////////////////
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// randomly initialises the weighted connections - 
-/// 
-/// The weighted connections are randomly initialised over the range
-/// -(initRange/2) to +(initRange/2).
-/// </summary>
-/// <param name="initRange">the range used for random initialisation</param>
-/// 
-void NNetWeightedConnect::initialiseWeights(double initRange)
-{	
-	// initialise a weight vector for each of the output nodes
-	for(int i = 0; i < mNumOutNodes; i++)
-	{		
-		vector<double> initVec;
-
-		// the size of the vector is equal to the number of input nodes
-		for(int j = 0; j < mNumInNodes; j++)
-		{
-			double initVal = rand();
-
-			// randomly iniialise a vector component
-			initVal = initRange * (initVal / RAND_MAX) - (initRange / 2);
-
-			initVec.push_back(initVal);
-		}
-
-		mWeights.push_back(initVec);
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// calculates the output values for all the output nodes
-/// </summary>
-/// 
-void NNetWeightedConnect::calculateOutput()
-{
-	if(!mOutputs.empty())
-	{
-		mOutputs.erase(mOutputs.begin(), mOutputs.end());
-	}
-
-	for(int i = 0; i < mNumOutNodes; i++)
-	{
-		double component = getNodeValue(i);
-
-		mOutputs.push_back(component);
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// calculates the output value for the given output node
-/// </summary>
-/// <param name="node">the index of the output node</param>
-///
-/// <returns>the value of the output node</returns>
-/// 
-double NNetWeightedConnect::getNodeValue(int node)
-{
-	double value = 0;
-	vector<double> nodeVec(mWeights[node].size());
-
-	copy(mWeights[node].begin(), mWeights[node].end(), nodeVec.begin());
-
-	if(mNumInNodes == (int)nodeVec.size())
-	{
-		for(int i = 0; i < mNumInNodes; i++)
-		{
-			value += nodeVec[i] * mInputs[i];
-		}
-	}
-
-	return value;
-}
-
-/////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////
+//
+// Implements the NNetWeightedConnect class
+//
+// Author: Jason Jenkins
+//
+// This class is used by the neural network class (NeuralNet) and
+// represents the weighted connections that link the layers of a 
+// neural network together.
+//
+// The layers of a neural network are connected by a system of
+// weighted connections. Each unit in a given layer of the network
+// (excluding the output layer) has a single connection to every 
+// unit in the next layer. These connections are initially given
+// a random value which is then updated when the neural network
+// is trained.
+//
+// In this class the weighted connections between two layers 
+// consist of a given number of input and output nodes. If the
+// first layer of a network contains three units and the second
+// layer contains four to connect these layers together we require
+// a weighted connection with three input nodes and four output
+// nodes.
+//
+// Each input node is connected to every output node. The input 
+// nodes have their values set by the setInputs method and these
+// values represent the activated output of a particular layer
+// within the network. The value of a specific output node is the
+// result of applying the weighted connections between that output
+// node and all the connected input nodes - each input node value is
+// multiplied by the weighted connection between the input node and 
+// the given output node in turn and the results are then summed to 
+// give the output node value. The output node values can be obtained
+// via the getOutputs method and these values can then be used by the
+// network as the input values to the activation functions of the
+// next layer.
+//
+// The weights of the connections between a given output node and
+// the input nodes can be retrieved via the getWeightVector method
+// and set via the setWeightVector method. These two methods are 
+// typically called by the network training process.
+//
+// Once a network is trained many of its weighted connections may be
+// close to zero. These connections can be removed by pruning - either
+// every connection whose magnitude is within a threshold or all but 
+// the largest few connections of each output node. Pruned weighted
+// connections are stored in compressed sparse row form: the remaining
+// weights of each output node are stored one after another along with
+// the index of the input node each one connects to. The memory used
+// and the work done in calculating the output values then depend on 
+// the number of remaining connections. The weight vector methods 
+// continue to work with full length vectors (with zeros in the place
+// of pruned connections) and any changes made to the pruned 
+// connections are ignored so that further training keeps them pruned.
+//
+// A network holds the weights of all its layers in one contiguous 
+// block (see NeuralNet) and each of its connections reads and updates
+// its own part of that block in place - see shareWeights. A connection
+// that is copied, or whose number of stored weights changes, goes back
+// to holding its weights in its own storage.
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetWeightedConnect.h"
+
+/////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include <algorithm>
+#include <utility>
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// default constructor
+/// </summary>
+/// 
+NNetWeightedConnect::NNetWeightedConnect()
+{
+	// default connection settings
+	mNumInNodes = -1;
+	mNumOutNodes = -1;
+	mSparse = false;
+
+	useOwnWeights();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// constructs a connection between the given number of nodes
+/// </summary>
+/// <param name="numInNodes">the number of input nodes</param>
+/// <param name="numOutNodes">the number of output nodes</param>
+/// 
+NNetWeightedConnect::NNetWeightedConnect(int numInNodes, int numOutNodes)
+{
+	mNumInNodes = -1;
+	mNumOutNodes = -1;
+	mSparse = false;
+
+	useOwnWeights();
+
+	// ignore invalid data
+	if(numInNodes > 0 && numOutNodes > 0)
+	{
+		mNumInNodes = numInNodes;
+		mNumOutNodes = numOutNodes;
+
+		initialiseWeights();
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// copy constructor - the copy always holds its weights in its own 
+/// storage, even when the other connection's weights are held in a 
+/// network's weight block
+/// </summary>
+/// <param name="other">the connection to be copied</param>
+/// 
+NNetWeightedConnect::NNetWeightedConnect(const NNetWeightedConnect& other)
+	: mNumInNodes(other.mNumInNodes), mNumOutNodes(other.mNumOutNodes),
+	  mInputs(other.mInputs), mOutputs(other.mOutputs), 
+	  mWeights(other.mWeightData, other.mWeightData + other.mNumWeights),
+	  mSparse(other.mSparse), mRowStarts(other.mRowStarts), mInputNodes(other.mInputNodes)
+{
+	useOwnWeights();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// move constructor - the weight storage is taken over rather than 
+/// copied and the other connection is left empty (weights held in a
+/// network's weight block are copied as they belong to the network)
+/// </summary>
+/// <param name="other">the connection whose weights are taken over</param>
+/// 
+NNetWeightedConnect::NNetWeightedConnect(NNetWeightedConnect&& other) noexcept
+	: mNumInNodes(other.mNumInNodes), mNumOutNodes(other.mNumOutNodes),
+	  mInputs(move(other.mInputs)), mOutputs(move(other.mOutputs)), mWeights(move(other.mWeights)),
+	  mSparse(other.mSparse), mRowStarts(move(other.mRowStarts)), mInputNodes(move(other.mInputNodes))
+{
+	if(other.mSharedWeights)
+	{
+		mWeights.assign(other.mWeightData, other.mWeightData + other.mNumWeights);
+	}
+
+	useOwnWeights();
+
+	other.mNumInNodes = -1;
+	other.mNumOutNodes = -1;
+	other.mSparse = false;
+	other.mWeights.clear();
+	other.useOwnWeights();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// destructor
+/// </summary>
+///
+NNetWeightedConnect::~NNetWeightedConnect()
+{
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// copy assignment - when this connection's weights are held in a 
+/// network's weight block and the other connection stores the same
+/// number of weights they are copied into the block, otherwise this
+/// connection holds its weights in its own storage
+/// </summary>
+/// <param name="other">the connection to be copied</param>
+/// <returns>this connection</returns>
+/// 
+NNetWeightedConnect& NNetWeightedConnect::operator=(const NNetWeightedConnect& other)
+{
+	if(this != &other)
+	{
+		mNumInNodes = other.mNumInNodes;
+		mNumOutNodes = other.mNumOutNodes;
+		mSparse = other.mSparse;
+
+		mInputs = other.mInputs;
+		mOutputs = other.mOutputs;
+		mRowStarts = other.mRowStarts;
+		mInputNodes = other.mInputNodes;
+
+		if(mSharedWeights && mNumWeights == other.mNumWeights)
+		{
+			copy(other.mWeightData, other.mWeightData + other.mNumWeights, mWeightData);
+		}
+		else
+		{
+			mWeights.assign(other.mWeightData, other.mWeightData + other.mNumWeights);
+			useOwnWeights();
+		}
+	}
+
+	return *this;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// move assignment - the weight storage is taken over rather than 
+/// copied and the other connection is left empty (weights held in a
+/// network's weight block are copied as they belong to the network)
+/// </summary>
+/// <param name="other">the connection whose weights are taken over</param>
+/// <returns>this connection</returns>
+/// 
+NNetWeightedConnect& NNetWeightedConnect::operator=(NNetWeightedConnect&& other) noexcept
+{
+	if(this != &other)
+	{
+		mNumInNodes = other.mNumInNodes;
+		mNumOutNodes = other.mNumOutNodes;
+		mSparse = other.mSparse;
+
+		mInputs = move(other.mInputs);
+		mOutputs = move(other.mOutputs);
+		mRowStarts = move(other.mRowStarts);
+		mInputNodes = move(other.mInputNodes);
+
+		if(other.mSharedWeights)
+		{
+			mWeights.assign(other.mWeightData, other.mWeightData + other.mNumWeights);
+		}
+		else
+		{
+			mWeights = move(other.mWeights);
+		}
+
+		useOwnWeights();
+
+		other.mNumInNodes = -1;
+		other.mNumOutNodes = -1;
+		other.mSparse = false;
+		other.mInputs.clear();
+		other.mOutputs.clear();
+		other.mWeights.clear();
+		other.mRowStarts.clear();
+		other.mInputNodes.clear();
+		other.useOwnWeights();
+	}
+
+	return *this;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Public Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets the number of input and output nodes - 
+/// 
+/// The weighted connections are randomly initialised over the range
+/// -(initRange/2) to +(initRange/2).
+/// </summary>
+/// <param name="numInNodes">the number of input nodes</param>
+/// <param name="numOutNodes">the number of output nodes</param>
+/// <param name="initRange">the range used for random initialisation</param>
+/// 
+void NNetWeightedConnect::setNumNodes(int numInNodes, int numOutNodes, double initRange)
+{
+	// ignore invalid data
+	if(numInNodes > 0 && numOutNodes > 0 && initRange > 0)
+	{
+		mNumInNodes = numInNodes;
+		mNumOutNodes = numOutNodes;
+
+		initialiseWeights(initRange);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets the number of input and output nodes with all the weighted 
+/// connections set to zero - 
+/// 
+/// This only sizes the weight storage, the random number generator is
+/// not used. It is intended for loading a network whose weights are 
+/// about to be written over.
+/// </summary>
+/// <param name="numInNodes">the number of input nodes</param>
+/// <param name="numOutNodes">the number of output nodes</param>
+/// 
+void NNetWeightedConnect::resize(int numInNodes, int numOutNodes)
+{
+	// ignore invalid data
+	if(numInNodes > 0 && numOutNodes > 0)
+	{
+		mNumInNodes = numInNodes;
+		mNumOutNodes = numOutNodes;
+
+		mWeights.assign((size_t)numInNodes * numOutNodes, 0.0);
+		mRowStarts.clear();
+		mInputNodes.clear();
+		mSparse = false;
+
+		useOwnWeights();
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets the input values for the weighted connection - 
+/// 
+/// The input value for the first input node is the first value stored
+/// in the list and the input value for the second input node is the
+/// second value stored in the list and so on.
+/// </summary>
+/// <param name="inputs">a vector of input values</param>
+/// 
+void NNetWeightedConnect::setInputs(const vector<double>& inputs)
+{
+	// make sure the size of the input vector corresponds to the number of input nodes
+	if((int)inputs.size() == mNumInNodes)
+	{
+		if(mInputs.empty())
+		{
+			mInputs.resize(mNumInNodes);
+		}
+
+		// copy will overwrite the original values
+		copy(inputs.begin(), inputs.end(), mInputs.begin());
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the output values for the weighted connection - 
+/// 
+/// The output values are calculated by applying the weighted
+/// connections to the input node values.
+/// </summary>
+/// <param name="outputs">the output values</param>
+/// 
+void NNetWeightedConnect::getOutputs(vector<double>& outputs)
+{
+	// resize the output vector if necessary
+	if((int)outputs.size() != mNumOutNodes)
+	{
+		outputs.resize(mNumOutNodes);
+	}
+
+	calculateOutput();
+
+	copy(mOutputs.begin(), mOutputs.end(), outputs.begin());
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// applies the weighted connections to the given input values - 
+/// 
+/// Unlike the setInputs/getOutputs pair this method reads the weights
+/// in place and writes directly into the caller's buffer so nothing is
+/// copied or allocated. The inputs buffer must hold one value for each
+/// input node and the outputs buffer one value for each output node.
+/// </summary>
+/// <param name="inputs">the input node values</param>
+/// <param name="outputs">the calculated output node values</param>
+/// 
+void NNetWeightedConnect::getOutputs(const double* inputs, double* outputs) const
+{
+	const double* weights = mWeightData;
+
+	if(mSparse)
+	{
+		// only the remaining connections of each output node are applied
+		const int* inputNodes = mInputNodes.data();
+
+		for(int i = 0; i < mNumOutNodes; i++)
+		{
+			double value = 0;
+
+			for(int c = mRowStarts[i]; c < mRowStarts[i + 1]; c++)
+			{
+				value += weights[c] * inputs[inputNodes[c]];
+			}
+
+			outputs[i] = value;
+		}
+
+		return;
+	}
+
+	for(int i = 0; i < mNumOutNodes; i++)
+	{
+		double value = 0;
+
+		for(int j = 0; j < mNumInNodes; j++)
+		{
+			value += weights[j] * inputs[j];
+		}
+
+		outputs[i] = value;
+		weights += mNumInNodes;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// applies the weighted connections to a block of input rows - 
+/// 
+/// The inputs are stored row by row with one value per input node and
+/// the outputs are written row by row with one value per output node.
+/// The rows are processed four at a time so each weight is loaded once
+/// and applied to all four rows, any remaining rows are processed one
+/// at a time. Each row is summed in the same order as the single row
+/// version so the results are identical.
+/// </summary>
+/// <param name="inputs">the input node values for each row</param>
+/// <param name="outputs">the calculated output node values for each row</param>
+/// <param name="numRows">the number of rows in the block</param>
+/// 
+void NNetWeightedConnect::getOutputs(const double* inputs, double* outputs, int numRows) const
+{
+	const int numIn = mNumInNodes;
+	const int numOut = mNumOutNodes;
+	int r = 0;
+
+	for(; r + 4 <= numRows; r += 4)
+	{
+		const double* in0 = inputs;
+		const double* in1 = in0 + numIn;
+		const double* in2 = in1 + numIn;
+		const double* in3 = in2 + numIn;
+
+		double* out0 = outputs;
+		double* out1 = out0 + numOut;
+		double* out2 = out1 + numOut;
+		double* out3 = out2 + numOut;
+
+		if(mSparse)
+		{
+			getSparseOutputs(in0, in1, in2, in3, out0, out1, out2, out3);
+		}
+		else
+		{
+			getDenseOutputs(in0, in1, in2, in3, out0, out1, out2, out3);
+		}
+
+		inputs += 4 * numIn;
+		outputs += 4 * numOut;
+	}
+
+	for(; r < numRows; r++)
+	{
+		getOutputs(inputs, outputs);
+
+		inputs += numIn;
+		outputs += numOut;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// applies the transposed weighted connections to a set of output 
+/// node errors - 
+/// 
+/// This is used by the training process to propagate the errors back
+/// through the network. The error for each input node is the sum over
+/// the output nodes of: gradient * output error * weight, where the 
+/// gradient is that of the input node's activation function. Pruned 
+/// connections are skipped.
+/// </summary>
+/// <param name="outputErrors">the error for each output node</param>
+/// <param name="gradients">the activation function gradient for each input node</param>
+/// <param name="inputErrors">the calculated error for each input node</param>
+/// 
+void NNetWeightedConnect::getInputErrors(const double* outputErrors, const double* gradients, 
+										 double* inputErrors) const
+{
+	if(mSparse)
+	{
+		for(int j = 0; j < mNumInNodes; j++)
+		{
+			inputErrors[j] = 0;
+		}
+
+		for(int k = 0; k < mNumOutNodes; k++)
+		{
+			for(int c = mRowStarts[k]; c < mRowStarts[k + 1]; c++)
+			{
+				int j = mInputNodes[c];
+
+				inputErrors[j] += gradients[j] * outputErrors[k] * mWeightData[c];
+			}
+		}
+	}
+	else
+	{
+		for(int j = 0; j < mNumInNodes; j++)
+		{
+			double error = 0;
+
+			for(int k = 0; k < mNumOutNodes; k++)
+			{
+				error += gradients[j] * outputErrors[k] * mWeightData[k * mNumInNodes + j];
+			}
+
+			inputErrors[j] = error;
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the weighted connections vector for a given output node - 
+/// 
+/// This method is typically called when training the network. The 
+/// vector holds a weight for every input node with pruned connections
+/// given a weight of zero.
+/// </summary>
+/// <param name="node">the index of the output node</param>
+/// <param name="weights">the weighted connections vector</param>
+/// 
+void NNetWeightedConnect::getWeightVector(int node, vector<double>& weights) const
+{
+	if(node < mNumOutNodes && node >= 0)
+	{
+		if(mSparse)
+		{
+			weights.assign(mNumInNodes, 0.0);
+
+			for(int c = mRowStarts[node]; c < mRowStarts[node + 1]; c++)
+			{
+				weights[mInputNodes[c]] = mWeightData[c];
+			}
+		}
+		else
+		{
+			const double* first = mWeightData + node * mNumInNodes;
+
+			weights.assign(first, first + mNumInNodes);
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the remaining weighted connections for a given output node 
+/// and the input nodes they connect to - 
+/// 
+/// Unless the connections have been pruned this is every connection
+/// and the input nodes are simply 0, 1, 2 ... The weights can be 
+/// updated and passed back to setWeightVector.
+/// </summary>
+/// <param name="node">the index of the output node</param>
+/// <param name="weights">the remaining weighted connections</param>
+/// <param name="inputNodes">the input node of each connection</param>
+/// 
+void NNetWeightedConnect::getWeightVector(int node, vector<double>& weights, vector<int>& inputNodes) const
+{
+	if(node < mNumOutNodes && node >= 0)
+	{
+		if(mSparse)
+		{
+			weights.assign(mWeightData + mRowStarts[node], mWeightData + mRowStarts[node + 1]);
+			inputNodes.assign(mInputNodes.begin() + mRowStarts[node], mInputNodes.begin() + mRowStarts[node + 1]);
+		}
+		else
+		{
+			getWeightVector(node, weights);
+
+			inputNodes.resize(mNumInNodes);
+
+			for(int j = 0; j < mNumInNodes; j++)
+			{
+				inputNodes[j] = j;
+			}
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets the weighted connections vector for a given output node - 
+/// 
+/// This method is typically called by the training process to update the weighted connections.
+/// </summary>
+/// <param name="node">the index of the output node</param>
+/// <param name="weights">the weighted connections vector</param>
+/// 
+void NNetWeightedConnect::setWeightVector(int node, const vector<double>& weights)
+{
+	if(node < mNumOutNodes && node >= 0)
+	{
+		if(mSparse)
+		{
+			int first = mRowStarts[node];
+			int numKept = mRowStarts[node + 1] - first;
+
+			if(mNumInNodes == (int)weights.size())
+			{
+				// a full length vector - only the remaining connections are updated
+				for(int c = first; c < first + numKept; c++)
+				{
+					mWeightData[c] = weights[mInputNodes[c]];
+				}
+			}
+			else if(numKept == (int)weights.size())
+			{
+				// the remaining connections as supplied by getWeightVector
+				copy(weights.begin(), weights.end(), mWeightData + first);
+			}
+		}
+		else if(mNumInNodes == (int)weights.size())
+		{
+			copy(weights.begin(), weights.end(), mWeightData + node * mNumInNodes);
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets direct access to the remaining weighted connections for a 
+/// given output node - 
+/// 
+/// Unlike getWeightVector nothing is copied, the weights can be read
+/// and updated in place. The input nodes pointer is set to NULL if the
+/// connections have not been pruned - every connection is then present
+/// and the input nodes are simply 0, 1, 2 ...
+/// </summary>
+/// <param name="node">the index of the output node</param>
+/// <param name="weights">set to point to the node's first weighted connection</param>
+/// <param name="inputNodes">set to point to the input node of each connection (or NULL)</param>
+/// <returns>the number of weighted connections</returns>
+/// 
+int NNetWeightedConnect::getRowWeights(int node, double*& weights, const int*& inputNodes)
+{
+	const double* constWeights = NULL;
+	int numWeights = static_cast<const NNetWeightedConnect&>(*this).getRowWeights(node, constWeights, inputNodes);
+
+	weights = const_cast<double*>(constWeights);
+
+	return numWeights;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets read only access to the remaining weighted connections for a
+/// given output node - see the non-const version
+/// </summary>
+/// <param name="node">the index of the output node</param>
+/// <param name="weights">set to point to the node's first weighted connection</param>
+/// <param name="inputNodes">set to point to the input node of each connection (or NULL)</param>
+/// <returns>the number of weighted connections</returns>
+/// 
+int NNetWeightedConnect::getRowWeights(int node, const double*& weights, const int*& inputNodes) const
+{
+	weights = NULL;
+	inputNodes = NULL;
+
+	if(node < mNumOutNodes && node >= 0)
+	{
+		if(mSparse)
+		{
+			int first = mRowStarts[node];
+
+			weights = mWeightData + first;
+			inputNodes = mInputNodes.data() + first;
+
+			return mRowStarts[node + 1] - first;
+		}
+		else
+		{
+			weights = mWeightData + node * mNumInNodes;
+
+			return mNumInNodes;
+		}
+	}
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// removes the weighted connections whose magnitude does not exceed a
+/// threshold - the remaining connections are stored in sparse form
+/// </summary>
+/// <param name="threshold">the pruning threshold (zero or more)</param>
+/// <returns>the number of remaining connections or -1 if the threshold is 
+/// negative or not a number</returns>
+/// 
+int NNetWeightedConnect::pruneByThreshold(double threshold)
+{
+	// written so that a NaN threshold is rejected as well
+	if(!(threshold >= 0))
+	{
+		return -1;
+	}
+
+	vector<bool> keep((size_t)mNumInNodes * mNumOutNodes, false);
+	vector<double> weights;
+
+	for(int i = 0; i < mNumOutNodes; i++)
+	{
+		getWeightVector(i, weights);
+
+		for(int j = 0; j < mNumInNodes; j++)
+		{
+			keep[(size_t)i * mNumInNodes + j] = fabs(weights[j]) > threshold;
+		}
+	}
+
+	return compressWeights(keep);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// keeps only the largest (by magnitude) weighted connections for 
+/// each output node - the remaining connections are stored in sparse
+/// form
+/// </summary>
+/// <param name="numKept">the number of connections kept for each output node (zero or more)</param>
+/// <returns>the number of remaining connections or -1 if the number kept is negative</returns>
+/// 
+int NNetWeightedConnect::pruneByTopK(int numKept)
+{
+	if(numKept < 0)
+	{
+		return -1;
+	}
+
+	vector<bool> keep((size_t)mNumInNodes * mNumOutNodes, false);
+	vector<int> order;
+
+	for(int i = 0; i < mNumOutNodes; i++)
+	{
+		const double* weights;
+		const int* inputNodes;
+		int numWeights = getRowWeights(i, weights, inputNodes);
+
+		// only the remaining connections are candidates - those already pruned stay pruned
+		order.resize(numWeights);
+
+		for(int c = 0; c < numWeights; c++)
+		{
+			order[c] = c;
+		}
+
+		// order the remaining connections by decreasing weight magnitude
+		stable_sort(order.begin(), order.end(), 
+					[weights](int a, int b) { return fabs(weights[a]) > fabs(weights[b]); });
+
+		for(int c = 0; c < numWeights && c < numKept; c++)
+		{
+			int node = (inputNodes != NULL) ? inputNodes[order[c]] : order[c];
+
+			keep[(size_t)i * mNumInNodes + node] = true;
+		}
+	}
+
+	return compressWeights(keep);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// removes the weighted connections that are not picked out by a mask
+/// (connections already pruned stay pruned) - the remaining connections
+/// are stored in sparse form. This restores the connections of a pruned
+/// layer exactly, including any remaining weights that are zero.
+/// </summary>
+/// <param name="keep">true for each connection (row by row) to be kept</param>
+/// <returns>the number of remaining connections or -1 if the mask is the wrong size</returns>
+/// 
+int NNetWeightedConnect::pruneByMask(const vector<bool>& keep)
+{
+	if(keep.size() != (size_t)mNumInNodes * mNumOutNodes)
+	{
+		return -1;
+	}
+
+	return compressWeights(keep);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets a mask of the weighted connections that have not been pruned
+/// </summary>
+/// <param name="present">receives true for each connection (row by row) that has not been pruned</param>
+/// 
+void NNetWeightedConnect::getConnectionMask(vector<bool>& present) const
+{
+	present.assign((size_t)mNumInNodes * mNumOutNodes, !mSparse);
+
+	if(mSparse)
+	{
+		for(int i = 0; i < mNumOutNodes; i++)
+		{
+			for(int c = mRowStarts[i]; c < mRowStarts[i + 1]; c++)
+			{
+				present[(size_t)i * mNumInNodes + mInputNodes[c]] = true;
+			}
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// restores the full (dense) storage of the weighted connections - the
+/// pruned connections are given a weight of zero and can be trained 
+/// again
+/// </summary>
+/// 
+void NNetWeightedConnect::makeDense()
+{
+	if(mSparse)
+	{
+		vector<double> dense((size_t)mNumInNodes * mNumOutNodes, 0.0);
+
+		for(int i = 0; i < mNumOutNodes; i++)
+		{
+			for(int c = mRowStarts[i]; c < mRowStarts[i + 1]; c++)
+			{
+				dense[(size_t)i * mNumInNodes + mInputNodes[c]] = mWeightData[c];
+			}
+		}
+
+		// the dense weights no longer fit any storage shared with a network
+		mWeights.swap(dense);
+		mRowStarts.clear();
+		mInputNodes.clear();
+		mSparse = false;
+
+		useOwnWeights();
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// checks whether another connection joins the same numbers of input
+/// and output nodes with the same remaining connections - the values 
+/// of the weights are not compared
+/// </summary>
+/// <param name="other">the other connection</param>
+/// <returns>true if the connections have the same structure</returns>
+/// 
+bool NNetWeightedConnect::hasSameConnections(const NNetWeightedConnect& other) const
+{
+	return mNumInNodes == other.mNumInNodes && mNumOutNodes == other.mNumOutNodes &&
+		   mSparse == other.mSparse && mRowStarts == other.mRowStarts && 
+		   mInputNodes == other.mInputNodes;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// moves the stored weighted connections into a block of memory owned
+/// by a network - 
+/// 
+/// The weights are copied into the block and read and updated there 
+/// from then on, so the network can hold the weights of all its layers
+/// in one contiguous block. The block must hold getNumConnections 
+/// values and remain valid until the connection is destroyed or given
+/// its own storage again. Anything that changes the number of stored
+/// weights (resizing, pruning or making the connections dense) moves
+/// them back into the connection's own storage, as does copying the
+/// connection.
+/// </summary>
+/// <param name="block">the block the weights are to be held in</param>
+/// 
+void NNetWeightedConnect::shareWeights(double* block)
+{
+	if(block != mWeightData)
+	{
+		copy(mWeightData, mWeightData + mNumWeights, block);
+	}
+
+	mWeightData = block;
+	mSharedWeights = true;
+
+	// the connection's own storage is no longer needed
+	vector<double>().swap(mWeights);
+}
+
+/////////////////////////////////////////////////////////////////////
+// Private Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// points the weight storage back at the connection's own weights - 
+/// called whenever they have been replaced
+/// </summary>
+/// 
+void NNetWeightedConnect::useOwnWeights()
+{
+	mWeightData = mWeights.data();
+	mNumWeights = (int)mWeights.size();
+	mSharedWeights = false;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// randomly initialises the weighted connections - 
+/// 
+/// The weighted connections are randomly initialised over the range
+/// -(initRange/2) to +(initRange/2).
+/// </summary>
+/// <param name="initRange">the range used for random initialisation</param>
+/// 
+void NNetWeightedConnect::initialiseWeights(double initRange)
+{	
+	mWeights.clear();
+	mRowStarts.clear();
+	mInputNodes.clear();
+	mSparse = false;
+
+	mWeights.reserve(mNumOutNodes * mNumInNodes);
+
+	// initialise a weight vector for each of the output nodes
+	for(int i = 0; i < mNumOutNodes; i++)
+	{		
+		// the size of the vector is equal to the number of input nodes
+		for(int j = 0; j < mNumInNodes; j++)
+		{
+			double initVal = rand();
+
+			// randomly iniialise a vector component
+			initVal = initRange * (initVal / RAND_MAX) - (initRange / 2);
+
+			mWeights.push_back(initVal);
+		}
+	}
+
+	useOwnWeights();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// calculates the output values for all the output nodes
+/// </summary>
+/// 
+void NNetWeightedConnect::calculateOutput()
+{
+	if(!mOutputs.empty())
+	{
+		mOutputs.erase(mOutputs.begin(), mOutputs.end());
+	}
+
+	for(int i = 0; i < mNumOutNodes; i++)
+	{
+		double component = getNodeValue(i);
+
+		mOutputs.push_back(component);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// calculates the output value for the given output node
+/// </summary>
+/// <param name="node">the index of the output node</param>
+///
+/// <returns>the value of the output node</returns>
+/// 
+double NNetWeightedConnect::getNodeValue(int node)
+{
+	double value = 0;
+
+	if(mSparse)
+	{
+		for(int c = mRowStarts[node]; c < mRowStarts[node + 1]; c++)
+		{
+			value += mWeightData[c] * mInputs[mInputNodes[c]];
+		}
+
+		return value;
+	}
+
+	const double* weights = mWeightData + node * mNumInNodes;
+
+	for(int i = 0; i < mNumInNodes; i++)
+	{
+		value += weights[i] * mInputs[i];
+	}
+
+	return value;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// stores the weighted connections picked out by a mask in sparse 
+/// form - the remaining connections are discarded, and connections 
+/// that have already been pruned stay pruned whatever the mask holds
+/// </summary>
+/// <param name="keep">true for each connection (row by row) to be kept</param>
+/// <returns>the number of remaining connections</returns>
+/// 
+int NNetWeightedConnect::compressWeights(const vector<bool>& keep)
+{
+	vector<double> sparseWeights;
+	vector<int> rowStarts, inputNodes;
+
+	rowStarts.push_back(0);
+
+	for(int i = 0; i < mNumOutNodes; i++)
+	{
+		const double* weights;
+		const int* rowNodes;
+		int numWeights = getRowWeights(i, weights, rowNodes);
+
+		// only the remaining connections are considered
+		for(int c = 0; c < numWeights; c++)
+		{
+			int node = (rowNodes != NULL) ? rowNodes[c] : c;
+
+			if(keep[(size_t)i * mNumInNodes + node])
+			{
+				sparseWeights.push_back(weights[c]);
+				inputNodes.push_back(node);
+			}
+		}
+
+		rowStarts.push_back((int)sparseWeights.size());
+	}
+
+	// the remaining weights are held in the connection's own storage
+	mWeights.swap(sparseWeights);
+	mRowStarts.swap(rowStarts);
+	mInputNodes.swap(inputNodes);
+	mSparse = true;
+
+	useOwnWeights();
+
+	return mNumWeights;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// applies the dense weighted connections to four input rows at once
+/// </summary>
+/// <param name="in0">the input node values for the first row</param>
+/// <param name="in1">the input node values for the second row</param>
+/// <param name="in2">the input node values for the third row</param>
+/// <param name="in3">the input node values for the fourth row</param>
+/// <param name="out0">the calculated output node values for the first row</param>
+/// <param name="out1">the calculated output node values for the second row</param>
+/// <param name="out2">the calculated output node values for the third row</param>
+/// <param name="out3">the calculated output node values for the fourth row</param>
+/// 
+void NNetWeightedConnect::getDenseOutputs(const double* in0, const double* in1, 
+										  const double* in2, const double* in3, 
+										  double* out0, double* out1, 
+										  double* out2, double* out3) const
+{
+	const double* weights = mWeightData;
+
+	for(int i = 0; i < mNumOutNodes; i++)
+	{
+		double value0 = 0;
+		double value1 = 0;
+		double value2 = 0;
+		double value3 = 0;
+
+		for(int j = 0; j < mNumInNodes; j++)
+		{
+			// each weight is loaded once and applied to all four rows
+			double weight = weights[j];
+
+			value0 += weight * in0[j];
+			value1 += weight * in1[j];
+			value2 += weight * in2[j];
+			value3 += weight * in3[j];
+		}
+
+		out0[i] = value0;
+		out1[i] = value1;
+		out2[i] = value2;
+		out3[i] = value3;
+
+		weights += mNumInNodes;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// applies the pruned weighted connections to four input rows at once
+/// </summary>
+/// <param name="in0">the input node values for the first row</param>
+/// <param name="in1">the input node values for the second row</param>
+/// <param name="in2">the input node values for the third row</param>
+/// <param name="in3">the input node values for the fourth row</param>
+/// <param name="out0">the calculated output node values for the first row</param>
+/// <param name="out1">the calculated output node values for the second row</param>
+/// <param name="out2">the calculated output node values for the third row</param>
+/// <param name="out3">the calculated output node values for the fourth row</param>
+/// 
+void NNetWeightedConnect::getSparseOutputs(const double* in0, const double* in1, 
+										   const double* in2, const double* in3, 
+										   double* out0, double* out1, 
+										   double* out2, double* out3) const
+{
+	const double* weights = mWeightData;
+	const int* inputNodes = mInputNodes.data();
+
+	for(int i = 0; i < mNumOutNodes; i++)
+	{
+		double value0 = 0;
+		double value1 = 0;
+		double value2 = 0;
+		double value3 = 0;
+
+		for(int c = mRowStarts[i]; c < mRowStarts[i + 1]; c++)
+		{
+			double weight = weights[c];
+			int j = inputNodes[c];
+
+			value0 += weight * in0[j];
+			value1 += weight * in1[j];
+			value2 += weight * in2[j];
+			value3 += weight * in3[j];
+		}
+
+		out0[i] = value0;
+		out1[i] = value1;
+		out2[i] = value2;
+		out3[i] = value3;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
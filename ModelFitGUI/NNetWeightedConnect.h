@@ -1,91 +1,205 @@
-/////////////////////////////////////////////////////////////////////
-//
-// Defines the NNetWeightedConnect class
-//
-// Author: Jason Jenkins
-//
-// This class is used by the neural network class (NeuralNet) and
-// represents the weighted connections that link the layers of a 
-// neural network together.
-//
-/////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-/////////////////////////////////////////////////////////////////////
-
-#include <vector>
-#include <string>
-
-/////////////////////////////////////////////////////////////////////
-
-using namespace std;
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// This class is used by the neural network class (NeuralNet) and represents
-/// the weighted connections that link the layers of a neural network together.
-/// </summary>
-/// 
-class NNetWeightedConnect
-{
-public:
-	NNetWeightedConnect();	
-	virtual ~NNetWeightedConnect();
-
-	// constructs a connection between the given number of nodes
-	NNetWeightedConnect(int numInNodes, int numOutNodes);	
-
-	// sets the number of input and output nodes
-	void setNumNodes(int numInNodes, int numOutNodes, double initRange = 2.0);
-
-	/// <summary>
-	/// <returns>the number of input nodes</returns>
-	/// </summary>
-	int getNumInputNodes () const { return mNumInNodes; }
-
-	/// <summary>
-	/// <returns>the number of output nodes</returns>
-	/// </summary>
-	int getNumOutputNodes () const { return mNumOutNodes; }
-
-	// sets the input values for the weighted connection
-	void setInputs(const vector<double>& inputs);
-
-	// gets the output values for the weighted connection
-	void getOutputs(vector<double>& outputs);
-
-	// gets the weighted connections vector for a given output node 
-	void getWeightVector(int node, vector<double>& weights);
-
-	// sets the weighted connections vector for a given output node 
-	void setWeightVector(int node, const vector<double>& weights);
-
-private:
-	// randomly initialises the weighted connections
-	void initialiseWeights(double initRange = 2.0);
-	
-	// calculates the output values for all the output nodes
-	void calculateOutput();
-	
-	// calculates the output value for the given output node
-	double getNodeValue(int node);
-
-private:
-	/// <summary>the number of input nodes</summary>
-	int mNumInNodes;
-
-	/// <summary>the number of output nodes</summary>
-	int mNumOutNodes;
-
-	/// <summary>the input values</summary>
-	vector<double> mInputs;
-
-	/// <summary>the output values</summary>
-	vector<double> mOutputs;
-
-	/// <summary>the weighted connection values</summary>
-	vector<vector<double> > mWeights;	
-};
-
-/////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NNetWeightedConnect class
+//
+// Author: Jason Jenkins
+//
+// This class is used by the neural network class (NeuralNet) and
+// represents the weighted connections that link the layers of a 
+// neural network together.
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <string>
+
+/////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class is used by the neural network class (NeuralNet) and represents
+/// the weighted connections that link the layers of a neural network together.
+/// </summary>
+/// 
+class NNetWeightedConnect
+{
+public:
+	NNetWeightedConnect();	
+	virtual ~NNetWeightedConnect();
+
+	// constructs a connection between the given number of nodes
+	NNetWeightedConnect(int numInNodes, int numOutNodes);	
+
+	// copies another connection into a new connection holding its own weights
+	NNetWeightedConnect(const NNetWeightedConnect& other);
+
+	// copies another connection into this connection
+	NNetWeightedConnect& operator=(const NNetWeightedConnect& other);
+
+	// moves the weighted connections of another connection into a new connection
+	NNetWeightedConnect(NNetWeightedConnect&& other) noexcept;
+
+	// moves the weighted connections of another connection into this connection
+	NNetWeightedConnect& operator=(NNetWeightedConnect&& other) noexcept;
+
+	// sets the number of input and output nodes
+	void setNumNodes(int numInNodes, int numOutNodes, double initRange = 2.0);
+
+	// sets the number of input and output nodes with the weights set to zero
+	void resize(int numInNodes, int numOutNodes);
+
+	/// <summary>
+	/// <returns>the number of input nodes</returns>
+	/// </summary>
+	int getNumInputNodes () const { return mNumInNodes; }
+
+	/// <summary>
+	/// <returns>the number of output nodes</returns>
+	/// </summary>
+	int getNumOutputNodes () const { return mNumOutNodes; }
+
+	// sets the input values for the weighted connection
+	void setInputs(const vector<double>& inputs);
+
+	// gets the output values for the weighted connection
+	void getOutputs(vector<double>& outputs);
+
+	// applies the weighted connections to the given input values
+	void getOutputs(const double* inputs, double* outputs) const;
+
+	// applies the weighted connections to a block of input rows
+	void getOutputs(const double* inputs, double* outputs, int numRows) const;
+
+	// applies the transposed weighted connections to a set of output node errors
+	void getInputErrors(const double* outputErrors, const double* gradients, double* inputErrors) const;
+
+	// gets the weighted connections vector for a given output node 
+	void getWeightVector(int node, vector<double>& weights) const;
+
+	// gets the remaining weighted connections for a given output node and their input nodes
+	void getWeightVector(int node, vector<double>& weights, vector<int>& inputNodes) const;
+
+	// sets the weighted connections vector for a given output node 
+	void setWeightVector(int node, const vector<double>& weights);
+
+	// gets direct access to the remaining weighted connections for a given output node
+	int getRowWeights(int node, double*& weights, const int*& inputNodes);
+	int getRowWeights(int node, const double*& weights, const int*& inputNodes) const;
+
+	// removes the weighted connections whose magnitude does not exceed a threshold
+	int pruneByThreshold(double threshold);
+
+	// keeps only the largest weighted connections for each output node
+	int pruneByTopK(int numKept);
+
+	// removes the weighted connections that are not picked out by a mask
+	int pruneByMask(const vector<bool>& keep);
+
+	// gets a mask of the weighted connections that have not been pruned
+	void getConnectionMask(vector<bool>& present) const;
+
+	// restores the full (dense) storage of the weighted connections
+	void makeDense();
+
+	// checks whether another connection joins the same nodes with the same remaining connections
+	bool hasSameConnections(const NNetWeightedConnect& other) const;
+
+	// moves the stored weighted connections into a block of memory owned by a network
+	void shareWeights(double* block);
+
+	/// <summary>
+	/// </summary>
+	/// <returns>true if the weights are held in a block of memory owned by a network</returns>
+	bool hasSharedWeights() const { return mSharedWeights; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>true if the connections have been pruned and are stored in sparse form</returns>
+	bool isSparse() const { return mSparse; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of weighted connections that have not been pruned</returns>
+	int getNumConnections() const { return mNumWeights; }
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the stored weighted connections - row by row, only the remaining 
+	/// connections once pruned (getNumConnections values)</returns>
+	const double* getWeightData() const { return mWeightData; }
+	double* getWeightData() { return mWeightData; }
+
+private:
+	// randomly initialises the weighted connections
+	void initialiseWeights(double initRange = 2.0);
+	
+	// calculates the output values for all the output nodes
+	void calculateOutput();
+	
+	// calculates the output value for the given output node
+	double getNodeValue(int node);
+
+	// stores the weighted connections picked out by a mask in sparse form
+	int compressWeights(const vector<bool>& keep);
+
+	// points the weight storage back at the connection's own weights
+	void useOwnWeights();
+
+	// applies the dense weighted connections to four input rows at once
+	void getDenseOutputs(const double* in0, const double* in1, const double* in2, const double* in3, 
+						 double* out0, double* out1, double* out2, double* out3) const;
+
+	// applies the pruned weighted connections to four input rows at once
+	void getSparseOutputs(const double* in0, const double* in1, const double* in2, const double* in3, 
+						  double* out0, double* out1, double* out2, double* out3) const;
+
+private:
+	/// <summary>the number of input nodes</summary>
+	int mNumInNodes;
+
+	/// <summary>the number of output nodes</summary>
+	int mNumOutNodes;
+
+	/// <summary>the input values</summary>
+	vector<double> mInputs;
+
+	/// <summary>the output values</summary>
+	vector<double> mOutputs;
+
+	/// <summary>
+	/// the weighted connection values - stored row by row so the weight
+	/// vector for each output node occupies a contiguous block of memory
+	/// (only the remaining connections are stored once pruned) - empty
+	/// while the weights are held in a network's weight block
+	/// </summary>
+	vector<double> mWeights;
+
+	/// <summary>the stored weighted connections - either mWeights or part of a network's weight block</summary>
+	double* mWeightData;
+
+	/// <summary>the number of stored weighted connections</summary>
+	int mNumWeights;
+
+	/// <summary>true if the weights are held in a block of memory owned by a network</summary>
+	bool mSharedWeights;
+
+	/// <summary>true if the connections have been pruned and are stored in sparse form</summary>
+	bool mSparse;
+
+	/// <summary>
+	/// the start of each output node's connections in the sparse form
+	/// (with a final entry marking the end of the last node)
+	/// </summary>
+	vector<int> mRowStarts;
+
+	/// <summary>the input node of each connection in the sparse form</summary>
+	vector<int> mInputNodes;
+};
+
+/////////////////////////////////////////////////////////////////////
@@ -0,0 +1,185 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Implements the NNetWorkspace class
+//
+// Author: Jason Jenkins
+//
+// This class holds the working values produced while a neural 
+// network (NeuralNet) calculates its response to a given input.
+//
+// For each layer of the network - the hidden layers followed by the
+// output layer - the workspace stores the unit input values (the 
+// result of applying the weighted connections into the layer) and 
+// the activation values of the layer's units. These are the values
+// the training process needs once a response has been calculated.
+//
+// Keeping these values apart from the network means a trained
+// network can be treated as read only: any number of threads can 
+// share one NeuralNet object and calculate responses at the same 
+// time as long as each thread supplies its own workspace.
+/*
+		NNetWorkspace workspace;	// one per thread
+		vector<double> outputs;
+
+		net.getResponse(inputs, outputs, workspace);
+*/
+// All of the values are held in a single block of memory (an arena)
+// laid out layer by layer - each layer's unit input values are 
+// immediately followed by its activation values - with a table of 
+// offsets giving the start of each layer. The forward and backward
+// passes therefore walk through one contiguous block and a copy of a
+// workspace is a single block copy.
+// 
+// The arena is sized the first time the workspace is used and is then
+// reused so subsequent responses do not allocate memory.
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetWorkspace.h"
+
+/////////////////////////////////////////////////////////////////////
+
+#include <utility>
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// default constructor
+/// </summary>
+/// 
+NNetWorkspace::NNetWorkspace()
+{
+	mChanged = false;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// move constructor - the other workspace is left empty
+/// </summary>
+/// <param name="other">the workspace whose buffers are taken over</param>
+/// 
+NNetWorkspace::NNetWorkspace(NNetWorkspace&& other) noexcept
+	: mArena(move(other.mArena)), mOffsets(move(other.mOffsets)), 
+	  mLayerSizes(move(other.mLayerSizes)), mChanged(other.mChanged)
+{
+	other.clearWorkspace();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// destructor
+/// </summary>
+///
+NNetWorkspace::~NNetWorkspace()
+{
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// move assignment - the other workspace is left empty
+/// </summary>
+/// <param name="other">the workspace whose buffers are taken over</param>
+/// <returns>this workspace</returns>
+/// 
+NNetWorkspace& NNetWorkspace::operator=(NNetWorkspace&& other) noexcept
+{
+	if(this != &other)
+	{
+		mArena = move(other.mArena);
+		mOffsets = move(other.mOffsets);
+		mLayerSizes = move(other.mLayerSizes);
+		mChanged = other.mChanged;
+
+		other.clearWorkspace();
+	}
+
+	return *this;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Public Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// clears a NNetWorkspace object ready for re-use
+/// </summary>
+/// 
+void NNetWorkspace::clearWorkspace()
+{
+	mArena.clear();
+	mOffsets.clear();
+	mLayerSizes.clear();
+	mChanged = false;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets the number of layers (including the output layer) - 
+/// 
+/// The sizes of the layers should then be set with setLayerSize 
+/// followed by a call to layoutLayers.
+/// </summary>
+/// <param name="numLayers">the number of layers</param>
+/// 
+void NNetWorkspace::setNumLayers(int numLayers)
+{
+	// ignore invalid values
+	if(numLayers >= 0 && numLayers != (int)mLayerSizes.size())
+	{
+		mLayerSizes.resize(numLayers, 0);
+		mOffsets.resize(numLayers, 0);
+		mChanged = true;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets the number of units in a layer - the new size takes effect 
+/// when layoutLayers is called
+/// </summary>
+/// <param name="layer">the specified layer</param>
+/// <param name="numUnits">the number of units in the layer</param>
+/// 
+void NNetWorkspace::setLayerSize(int layer, int numUnits)
+{
+	// ignore invalid values
+	if(layer >= 0 && layer < (int)mLayerSizes.size() && numUnits >= 0 &&
+	   numUnits != mLayerSizes[layer])
+	{
+		mLayerSizes[layer] = numUnits;
+		mChanged = true;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// lays the layer buffers out in the arena once the layer sizes have 
+/// been set - 
+/// 
+/// Nothing is done unless the layer sizes have changed so this method 
+/// only allocates memory the first time a workspace is used (or when 
+/// it is used with a different network). Any pointers previously 
+/// returned by getActivations or getUnitInputs are invalidated if the
+/// layout changes.
+/// </summary>
+/// 
+void NNetWorkspace::layoutLayers()
+{
+	if(mChanged)
+	{
+		int offset = 0;
+
+		for(int i = 0; i < (int)mLayerSizes.size(); i++)
+		{
+			mOffsets[i] = offset;
+
+			// the unit input values followed by the activation values
+			offset += 2 * mLayerSizes[i];
+		}
+
+		mArena.assign(offset, 0.0);
+		mChanged = false;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
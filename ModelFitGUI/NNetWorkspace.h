@@ -0,0 +1,97 @@
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NNetWorkspace class
+//
+// Author: Jason Jenkins
+//
+// This class holds the working values produced while a neural 
+// network (NeuralNet) calculates its response to a given input.
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class holds the working values produced while a neural 
+/// network (NeuralNet) calculates its response to a given input.
+/// </summary>
+/// 
+class NNetWorkspace
+{
+public:
+	NNetWorkspace();
+	virtual ~NNetWorkspace();
+
+	NNetWorkspace(const NNetWorkspace& other) = default;
+	NNetWorkspace& operator=(const NNetWorkspace& other) = default;
+
+	// moves the buffers of another workspace into a new workspace
+	NNetWorkspace(NNetWorkspace&& other) noexcept;
+
+	// moves the buffers of another workspace into this workspace
+	NNetWorkspace& operator=(NNetWorkspace&& other) noexcept;
+
+	// clears a NNetWorkspace object ready for re-use
+	void clearWorkspace();
+
+	// sets the number of layers (including the output layer) 
+	void setNumLayers(int numLayers);
+
+	// sets the number of units in a layer
+	void setLayerSize(int layer, int numUnits);
+
+	// lays the layer buffers out in the arena once the layer sizes have been set
+	void layoutLayers();
+
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of layers (including the output layer)</returns>
+	int getNumLayers() const { return (int)mLayerSizes.size(); }
+
+	/// <summary>
+	/// </summary>
+	/// <param name="layer">the specified layer</param>
+	/// <returns>the number of units in the specified layer</returns>
+	int getLayerSize(int layer) const { return mLayerSizes[layer]; }
+
+	/// <summary>
+	/// </summary>
+	/// <param name="layer">the specified layer</param>
+	/// <returns>the activation values for the specified layer</returns>
+	double* getActivations(int layer) { return mArena.data() + mOffsets[layer] + mLayerSizes[layer]; }
+	const double* getActivations(int layer) const { return mArena.data() + mOffsets[layer] + mLayerSizes[layer]; }
+
+	/// <summary>
+	/// </summary>
+	/// <param name="layer">the specified layer</param>
+	/// <returns>the unit input values for the specified layer</returns>
+	double* getUnitInputs(int layer) { return mArena.data() + mOffsets[layer]; }
+	const double* getUnitInputs(int layer) const { return mArena.data() + mOffsets[layer]; }
+
+private:
+	/// <summary>
+	/// the unit input values followed by the activation values of each 
+	/// layer in turn, all held in one contiguous block of memory
+	/// </summary>
+	vector<double> mArena;
+
+	/// <summary>the start of each layer's values in the arena</summary>
+	vector<int> mOffsets;
+
+	/// <summary>the number of units in each layer</summary>
+	vector<int> mLayerSizes;
+
+	/// <summary>true if the layer sizes have changed since the arena was laid out</summary>
+	bool mChanged;
+};
+
+/////////////////////////////////////////////////////////////////////
@@ -1,674 +1,1876 @@
-/////////////////////////////////////////////////////////////////////
-//
-// Implements the NeuralNet class
-//
-// Author: Jason Jenkins
-//
-// This class is a representation of a feedforward neural network.
-//
-// This class enables a neural network to be built comprising single 
-// or multiple input and output values along with one or more hidden
-// layers.
-//
-// The output and hidden layers can consist of any number of units
-// or neurons and each layer can be given their own activation 
-// function, to be used by all the units in that layer, from a 
-// selection of available types:
-//
-// Threshold, Unipolar, Bipolar, Tanh, Gaussian, Arctan, Sine,
-// Cosine, Sinc, Elliot, Linear, ISRU, SoftSign and SoftPlus.
-//
-// The activation function values can also be modified using two
-// parameters: slope and amplify (see NNetUnit.cpp for details). 
-//
-// A NeuralNet object can be serialized to and de-serialized from
-// a string representation which can be written to or read from a
-// file. This allows a neural network to be used once training is
-// complete or to continue training if required.
-//
-// The following code creates a neural network with 2 input units, 3
-// output units and 2 hidden layers with 4 and 6 units respectively.
-// The output units will use unipolar activation functions and the
-// the hidden layer units will both use bipolar activation functions.
-/*		
-		NeuralNet net;		
-		net.setNumInputs(2);
-		net.setNumOutputs(3);
-		net.setOutputUnitType(kUnipolar);
-		net.addLayer(4, kBipolar);		// the first hidden layer
-		net.addLayer(6, kBipolar);		// the second hidden layer
-*/
-// To use the neural network, once it has been trained, populate a
-// vector with the desired input values and call the getResponse
-// method to populate another vector with the output values.
-/*
-		vector<double> inputs;
-		vector<double> outputs;
-		inputs.push_back(0.5);
-		inputs.push_back(0.2);
-		net.getResponse(inputs, outputs);
-
-		double outputValue1 = outputs[0];
-		double outputValue2 = outputs[1];
-		double outputValue3 = outputs[2];
-*/
-//
-/////////////////////////////////////////////////////////////////////
-
-#include "NeuralNet.h"
-
-/////////////////////////////////////////////////////////////////////
-
-#include <iostream>
-#include <sstream>
-#include <fstream>
-#include <iomanip>
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// default constructor
-/// </summary>
-/// 
-NeuralNet::NeuralNet()
-{
-	mNumInputs = 0;
-	mNumOutputs = 0;
-	mNumLayers = 0;
-
-	// default output unit settings
-	mOutUnitType = kThreshold;
-	mOutUnitSlope = 1.0;
-	mOutUnitAmplify = 1.0;
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// constructs a NeuralNet object from a file containing a network in 
-/// serialized form
-/// </summary>
-/// <param name="fname">the file containing the serialized data</param>
-/// 
-NeuralNet::NeuralNet(const string& fname)
-{
-	ifstream inFile(fname);
-
-	if(inFile.good())
-	{		
-		// find the length of the file
-		inFile.seekg (0, inFile.end);
-		int length = (int)inFile.tellg();
-		inFile.seekg (0, inFile.beg);
-
-		// create a suitably sized buffer
-		char* buffer = new char[length];
-
-		// read the data into the buffer
-		inFile.read(buffer, length);
-
-		// instantiate the network
-		deserialize(buffer);
-
-		delete[] buffer;
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// destructor
-/// </summary>
-///
-NeuralNet::~NeuralNet()
-{
-}
-
-/////////////////////////////////////////////////////////////////////
-// Public Methods
-/////////////////////////////////////////////////////////////////////
-
-/// <summary>
-/// clears a NeuralNet object ready for re-use
-/// </summary>
-/// 
-void NeuralNet::clearNeuralNetwork()
-{
-	mNumInputs = 0;
-	mNumOutputs = 0;
-	mNumLayers = 0;
-	mOutUnitType = kThreshold;
-	mOutUnitSlope = 1;
-	mOutUnitAmplify = 1;
-
-	mLayers.clear();
-	mActivations.clear();
-	mUnitInputs.clear();
-	mActiveUnits.clear();
-	mActiveSlope.clear();
-	mActiveAmplify.clear();
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// sets the number of input units
-/// </summary>
-/// <param name="numInputs">the number of input units</param>
-///
-void NeuralNet::setNumInputs(int numInputs)
-{
-	// ignore invalid values
-	if(numInputs > 0)
-	{
-		mNumInputs = numInputs;
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// sets the number of output units
-/// </summary>
-/// <param name="numOutputs">the number of output units</param>
-///
-void NeuralNet::setNumOutputs(int numOutputs)
-{
-	// ignore invalid values
-	if(numOutputs > 0)
-	{
-		mNumOutputs = numOutputs;
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// sets the output layer units activation function type
-/// </summary>
-/// <param name="unitType">the activation function type</param>
-///
-void NeuralNet::setOutputUnitType(ActiveT unitType)
-{
-	mOutUnitType = unitType;
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// sets the output layer units activation function slope value
-/// </summary>
-/// <param name="slope">the slope value for the activation function</param>
-///
-void NeuralNet::setOutputUnitSlope(double slope)
-{
-	// ignore invalid values
-	if(slope > 0)
-	{
-		mOutUnitSlope = slope;
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// sets the output layer units activation function amplify value
-/// </summary>
-/// <param name="amplify">the amplify value for the activation function</param>
-///
-void NeuralNet::setOutputUnitAmplify(double amplify)
-{
-	// ignore invalid values
-	if(amplify > 0)
-	{
-		mOutUnitAmplify = amplify;
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// adds a new hidden layer - 
-/// 
-/// The hidden layers are stored in the order of calls to this method
-/// so the first call to addlayer creates the first hidden layer, the
-/// second call creates the second layer and so on.
-/// </summary>
-/// <param name="numUnits">the number of units in the hidden layer</param>
-/// <param name="unitType">the layer unit activation function type 
-///                        (defaults to unipolar)</param>
-/// <param name="initRange">the range of the initial weighted connection
-///                         values (defaults to 2 coressponding to -1 to +1)</param>
-/// <param name="slope">the layer unit activation function slope value 
-///                     (defaults to 1.0)</param>
-/// <param name="amplify">the layer unit activation function amplify 
-///                       value (defaults to 1.0)</param>
-///
-/// <returns>0 if the layer is successfully added otherwise -1</returns>
-/// 
-int NeuralNet::addLayer(int numUnits, ActiveT unitType, double initRange, double slope, double amplify)
-{
-	NNetWeightedConnect connect, output;
-
-	// ignore invalid values
-	if(numUnits > 0 && initRange > 0 && slope > 0 && amplify > 0)
-	{
-		if(mNumLayers == 0)
-		{
-			// configure the first hidden layer
-			if(mNumInputs > 0)
-			{
-				// set up the weighted connections between the input and the first layer
-				// the weighted connections are initialised with random values in the
-				// range: -(initRange / 2) to +(initRange / 2)
-				connect.setNumNodes(mNumInputs, numUnits, initRange);
-
-				// store the unit type for the layer
-				mActiveUnits.push_back(unitType);
-
-				// store the steepness of the activation function's slope
-				mActiveSlope.push_back(slope);
-
-				// store the amplification factor of the activation function
-				mActiveAmplify.push_back(amplify);
-
-				mNumLayers++;			
-			}
-			else
-			{
-				return -1;
-			}
-		}
-		else
-		{		
-			// configure subsequent hidden layers
-			if(mNumLayers > 0)
-			{
-				int nInputs = mLayers[mNumLayers - 1].getNumOutputNodes();
-
-				// set up the weighted connections between the previous layer and the new one
-				// the weighted connections are initialised with random values in the
-				// range: -(initRange / 2) to +(initRange / 2)
-				connect.setNumNodes(nInputs, numUnits, initRange);
-
-				// store the unit type for the layer
-				mActiveUnits.push_back(unitType);
-
-				// store the steepness of the activation function's slope
-				mActiveSlope.push_back(slope);
-
-				// store the amplification factor of the activation function
-				mActiveAmplify.push_back(amplify);
-
-				mNumLayers++;
-			}
-			else
-			{
-				return -1;
-			}
-		}
-
-		// connect the last hidden layer to the output layer
-		if(mNumLayers > 1)
-		{
-			// overwrite the old output connections
-			mLayers[mNumLayers - 1] = connect;
-		}
-		else
-		{
-			// add the connections for the first layer
-			mLayers.push_back(connect);
-		}
-
-		// set up the weighted connections between the last layer and the output
-		output.setNumNodes(numUnits, mNumOutputs, initRange);
-
-		// add the output connections
-		mLayers.push_back(output);
-	}
-	else
-	{
-		return -1;
-	}
-
-	return 0;
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// gets the details of the specified hidden layer
-/// </summary>
-/// <param name="n">the specified hidden layer index</param>
-/// <param name="unitType">the layer unit activation function type</param>
-/// <param name="slope">the layer unit activation function slope value</param>
-/// <param name="amplify">the layer unit activation function amplify value</param>
-/// 
-void NeuralNet::getLayerDetails(int n, ActiveT& unitType, double& slope, double& amplify)
-{
-	if(n >= 0 && n < mNumLayers)
-	{
-		unitType = mActiveUnits[n];
-		slope = mActiveSlope[n];
-		amplify = mActiveAmplify[n];
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// gets the response of the network to the given input - 
-/// 
-/// The number of elements in the inputs vector should correspond to 
-/// the number of the input units.  If the inputs vector contains 
-/// more elements than this, the additional input values are ignored.
-/// </summary>
-/// <param name="inputs">the network input values</param>
-/// <param name="outputs">the network output values</param>
-/// 
-void NeuralNet::getResponse(const vector<double>& inputs, vector<double>& outputs)
-{
-	vector<double> inputVec;
-	vector<double> outputVec;
-	NNetWeightedConnect connect;
-
-	if((int)inputs.size() >= mNumInputs && mNumLayers > 0)
-	{
-		// clear any old activation and unit input values
-		mActivations.clear();
-		mUnitInputs.clear();
-
-		// 'load' the input vector 
-		for(int i = 0; i < mNumInputs; i++)
-		{
-			inputVec.push_back(inputs[i]);
-		}
-
-		// get the weighted connections between the input layer and first layer
-		connect = mLayers[0];
-		
-		// apply the weighted connections
-		connect.setInputs(inputVec);
-		connect.getOutputs(outputVec);
-
-		// store the output vector - this contains the unit input values
-		mUnitInputs.push_back(outputVec);
-
-		// clear the input vector so it can be used to hold the input for the next layer
-		inputVec.clear();
-
-		// set the unit type, slope and amplification for the first layer
-		NNetUnit unit(mActiveUnits[0], mActiveSlope[0], mActiveAmplify[0]);
-
-		// activate the net units
-		for(int i = 0; i < (int)outputVec.size(); i++)
-		{
-			unit.setInput(outputVec[i]);
-			inputVec.push_back(unit.getActivation());
-		}
-
-		// store the activations
-		mActivations.push_back(inputVec);
-
-		// propagate the data through the remaining layers
-		for(int i = 1; i <= mNumLayers; i++)	// use <= to include the output layer
-		{			
-			// get the weighted connections linking the next layer
-			connect = mLayers[i];			
-
-			// apply the weighted connections
-			outputVec.clear();
-			connect.setInputs(inputVec);
-			connect.getOutputs(outputVec);
-			inputVec.clear();
-
-			// store the output vector - this contains the unit input values
-			mUnitInputs.push_back(outputVec);
-
-			if(i < mNumLayers)
-			{
-				// set the unit type, slope and amplification for the next hidden layer
-				unit.setActivationType(mActiveUnits[i]);
-				unit.setSlope(mActiveSlope[i]);
-				unit.setAmplify(mActiveAmplify[i]);
-			}
-			else
-			{
-				// set the unit type, slope and amplification for the output layer
-				unit.setActivationType(mOutUnitType);
-				unit.setSlope(mOutUnitSlope);
-				unit.setAmplify(mOutUnitAmplify);
-			}
-
-			// activate the net units
-			for(int j = 0; j < (int)outputVec.size(); j++)
-			{
-				unit.setInput(outputVec[j]);
-				inputVec.push_back(unit.getActivation());
-			}
-
-			// store the activations
-			mActivations.push_back(inputVec);
-		}
-	
-		// copy the results into the output vector
-		if(outputs.size() > 0) outputs.clear();
-		outputs = inputVec;
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// gets the activation values for a specified layer - 
-/// 
-/// This method is typically called by the training process to access
-/// the activation values of the hidden and output layers.
-/// </summary>
-/// <param name="activations">the activation values for the layer</param>
-/// <param name="layer">the specified layer</param>
-/// 
-void NeuralNet::getActivations(vector<double>& activations, int layer)
-{
-	if(layer >= 0 && layer < (int)mActivations.size())
-	{
-		activations = mActivations[layer];
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// gets the unit input values for a specified layer - 
-/// 
-/// This method is typically called by the training process to access
-/// the input values to the hidden and output layer activation functions.
-/// </summary>
-/// <param name="inputs">the unit input values for the layer</param>
-/// <param name="layer">the specified layer</param>
-/// 
-void NeuralNet::getUnitInputs(vector<double>& inputs, int layer)
-{
-	if(layer >= 0 && layer < (int)mUnitInputs.size())
-	{
-		inputs = mUnitInputs[layer];
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// gets the weighted connections for a specified layer - 
-/// 
-/// This method is typically called by the training process to access 
-/// the weighted connections.
-/// </summary>
-/// <param name="wtConnect">the weighted connections between the 
-///                         specified layer and the next sequential
-///                         layer in the network.</param>
-/// <param name="layer">the specified layer</param>
-/// 
-void NeuralNet::getWeightedConnect(NNetWeightedConnect& wtConnect, int layer)
-{
-	if(layer >= 0 && layer < (int)mLayers.size())
-	{
-		wtConnect = mLayers[layer];
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// sets the weighted connections for a specified layer - 
-/// 
-/// This method is typically called by the training process to update 
-/// the weighted connections.
-/// </summary>
-/// <param name="wtConnect">the weighted connections between the 
-///                         specified layer and the next sequential 
-///                         layer in the network</param>
-/// <param name="layer">the specified layer</param>
-/// 
-void NeuralNet::setWeightedConnect(const NNetWeightedConnect& wtConnect, int layer)
-{
-	if(layer >= 0 && layer < (int)mLayers.size())
-	{
-		mLayers[layer] = wtConnect;
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// serializes this network and writes it to a file
-/// </summary>
-/// <param name="fname">the file to write the data to</param>
-/// <returns>0 if successful otherwise -1</returns>
-/// 
-int NeuralNet::writeToFile(const string& fname)
-{
-	ofstream outFile(fname);
-
-	if(outFile.good())
-	{
-		outFile << serialize();
-	}
-	else
-	{
-		return -1;
-	}
-
-	return 0;
-}
-
-/////////////////////////////////////////////////////////////////////
-// Private Methods
-/////////////////////////////////////////////////////////////////////
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// generates a string representation of this network
-/// </summary>
-/// <returns>a string representation of this network</returns>
-/// 
-string NeuralNet::serialize()
-{
-	vector<double> weights;
-	ostringstream outStream;		
-
-	outStream << std::setprecision(16);
-
-	// serialize the main details
-	outStream << mNumInputs << " " <<
-			     mNumOutputs << " " <<
-				 mNumLayers << " " <<
-				 mOutUnitType << " " <<
-				 mOutUnitSlope << " " <<
-				 mOutUnitAmplify << " ";
-
-	// serialize the layer data
-	for(int i = 0; i <= mNumLayers; i++)		// use <= to include the output layer
-	{
-		NNetWeightedConnect connect = mLayers[i];
-		int nIn = connect.getNumInputNodes();
-		int nOut = connect.getNumOutputNodes();
-		int nUnit = 0;
-		double sUnit = 0.0, aUnit = 0.0;
-
-		// get the unit type, slope and amplification for the hidden layer
-		if(i < mNumLayers) nUnit = (int)mActiveUnits[i];
-		if(i < mNumLayers) sUnit = mActiveSlope[i];
-		if(i < mNumLayers) aUnit = mActiveAmplify[i];
-
-		outStream << "L " << nIn << " " << nOut << " " << nUnit << " " << sUnit << " " << aUnit << " ";
-
-		for(int j = 0; j < nOut; j++)
-		{
-			connect.getWeightVector(j, weights);
-
-			for(int k = 0; k < nIn; k++)
-			{
-				outStream << weights[k] << " ";
-			}
-		}
-	}
-
-	// terminate the output string
-	outStream << endl;
-
-	return outStream.str();
-}
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// instantiates this network from a given string representation
-/// </summary>
-/// <param name="inData">the given string representation of the network</param>
-/// 
-void NeuralNet::deserialize(const string& inData)
-{	
-	istringstream inStream(inData);	
-
-	if(!inStream.good())
-	{
-		cerr << "Error deserializing!" << endl;
-	}
-	else
-	{
-		int outUnitType;
-
-		// deserialize the main details
-		inStream >> mNumInputs;
-		inStream >> mNumOutputs;
-		inStream >> mNumLayers;
-		inStream >> outUnitType;
-		inStream >> mOutUnitSlope;
-		inStream >> mOutUnitAmplify;
-
-		mOutUnitType = (ActiveT)outUnitType;
-
-		// deserialize the layer data
-		for(int i = 0; i <= mNumLayers; i++)		// use <= to include the output layer
-		{
-			char delim;
-			int nIn, nOut, nUnit;
-			double sUnit, aUnit;
-			
-			inStream >> delim;
- 			inStream >> nIn;
-			inStream >> nOut;
-			inStream >> nUnit;
-			inStream >> sUnit;
-			inStream >> aUnit;
-
-			NNetWeightedConnect connect(nIn, nOut);
-
-			for(int j = 0; j < nOut; j++)
-			{
-				vector<double> weights;
-
-				for(int k = 0; k < nIn; k++)
-				{
-					double wgt;
-
-					inStream >> wgt;
-
-					weights.push_back(wgt);
-				}
-
-				connect.setWeightVector(j, weights);
-			}
-
-			mLayers.push_back(connect);
-			mActiveUnits.push_back((ActiveT)nUnit);
-			mActiveSlope.push_back(sUnit);
-			mActiveAmplify.push_back(aUnit);
-		}
-	}
-}
-
-/////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////
+//
+// Implements the NeuralNet class
+//
+// Author: Jason Jenkins
+//
+// This class is a representation of a feedforward neural network.
+//
+// This class enables a neural network to be built comprising single 
+// or multiple input and output values along with one or more hidden
+// layers.
+//
+// The output and hidden layers can consist of any number of units
+// or neurons and each layer can be given their own activation 
+// function, to be used by all the units in that layer, from a 
+// selection of available types:
+//
+// Threshold, Unipolar, Bipolar, Tanh, Gaussian, Arctan, Sine,
+// Cosine, Sinc, Elliot, Linear, ISRU, SoftSign and SoftPlus.
+//
+// The activation function values can also be modified using two
+// parameters: slope and amplify (see NNetUnit.cpp for details). 
+//
+// A NeuralNet object can be serialized to and de-serialized from
+// a string representation which can be written to or read from a
+// file. This allows a neural network to be used once training is
+// complete or to continue training if required.
+//
+// For large networks the binary form written by writeToBinaryFile is
+// much smaller and faster to read and write: the weighted connections
+// of each layer are stored as a raw little-endian block which is 
+// copied in and out of the network in one go (see NNetBinaryFormat.cpp
+// for the layout). The file constructor recognises both forms. The 
+// weights of any layer can be stored as 16 bit fp16 or bf16 values to
+// make the file smaller still (see NNetHalf.h).
+//
+// The weights of every layer are held in a single contiguous block 
+// of memory, one layer after another, with each layer's weighted
+// connections working on their own part of the block in place. A
+// snapshot of the weights (getWeights) or its restoration (setWeights)
+// is then a single block copy and the forward and backward passes walk
+// through the weights in order. Anything that changes the number of 
+// weights a layer stores (such as pruning through getWeightedConnect)
+// takes that layer out of the block until packWeights is called - the
+// network still works meanwhile, layer by layer.
+/*
+		net.writeToBinaryFile("network.bin");
+		net.writeToBinaryFile("compact.bin", kBFloat16);
+
+		NeuralNet copy("network.bin");
+*/
+//
+// The following code creates a neural network with 2 input units, 3
+// output units and 2 hidden layers with 4 and 6 units respectively.
+// The output units will use unipolar activation functions and the
+// the hidden layer units will both use bipolar activation functions.
+/*		
+		NeuralNet net;		
+		net.setNumInputs(2);
+		net.setNumOutputs(3);
+		net.setOutputUnitType(kUnipolar);
+		net.addLayer(4, kBipolar);		// the first hidden layer
+		net.addLayer(6, kBipolar);		// the second hidden layer
+*/
+// To use the neural network, once it has been trained, populate a
+// vector with the desired input values and call the getResponse
+// method to populate another vector with the output values.
+/*
+		vector<double> inputs;
+		vector<double> outputs;
+		inputs.push_back(0.5);
+		inputs.push_back(0.2);
+		net.getResponse(inputs, outputs);
+
+		double outputValue1 = outputs[0];
+		double outputValue2 = outputs[1];
+		double outputValue3 = outputs[2];
+*/
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "NeuralNet.h"
+#include "NNetFrozen.h"
+#include "NNetBinaryFormat.h"
+#include "NNetLocale.h"
+
+/////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <thread>
+#include <cstring>
+#include <cstdlib>
+#include <climits>
+#include <cctype>
+#include <cstdarg>
+#include <cstdio>
+#include <utility>
+
+/////////////////////////////////////////////////////////////////////
+
+// the number of rows propagated through the network together by the batch methods
+static const int kBatchBlockRows = 256;
+
+// the minimum number of rows worth handing to a separate thread
+static const int kMinRowsPerThread = 4096;
+
+// the size of the buffer used to write a network to a text file
+static const size_t kTextBufferSize = 65536;
+
+// room for the longest single item written to a text file
+static const size_t kMaxTextItem = 128;
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// reads an integer from a text buffer skipping any leading white space
+/// </summary>
+/// <param name="pos">the read position - moved past the integer</param>
+/// <param name="value">receives the integer</param>
+/// <returns>true if successful or false if there is no integer to read</returns>
+/// 
+static bool readInt(const char*& pos, int& value)
+{
+	char* end;
+	long number = strtol(pos, &end, 10);
+
+	if(end == pos || number < INT_MIN || number > INT_MAX)
+	{
+		return false;
+	}
+
+	value = (int)number;
+	pos = end;
+
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// reads a floating point value from a text buffer skipping any 
+/// leading white space - the value is read in the "C" locale so the
+/// file is read the same way whatever locale is set
+/// </summary>
+/// <param name="pos">the read position - moved past the value</param>
+/// <param name="value">receives the value</param>
+/// <returns>true if successful or false if there is no value to read</returns>
+/// 
+static bool readDouble(const char*& pos, double& value)
+{
+	char* end;
+
+	value = NNetLocale::toDouble(pos, &end);
+
+	if(end == pos)
+	{
+		return false;
+	}
+
+	pos = end;
+
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// reads a single character tag from a text buffer skipping any 
+/// leading white space
+/// </summary>
+/// <param name="pos">the read position - moved past the tag</param>
+/// <param name="tag">the expected tag</param>
+/// <returns>true if the tag is found</returns>
+/// 
+static bool readTag(const char*& pos, char tag)
+{
+	while(isspace((unsigned char)*pos))
+	{
+		pos++;
+	}
+
+	if(*pos != tag)
+	{
+		return false;
+	}
+
+	pos++;
+
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// formats an item into a text buffer - the buffer is written to the
+/// stream first if it is too full to take the item. The item is 
+/// formatted in the "C" locale so the file is the same whatever 
+/// locale is set.
+/// </summary>
+/// <param name="outStream">the stream the buffer is written to</param>
+/// <param name="buffer">the buffer (kTextBufferSize characters long)</param>
+/// <param name="used">the number of characters in the buffer - updated</param>
+/// <param name="format">the printf style format of the item</param>
+/// 
+static void writeText(ostream& outStream, char* buffer, size_t& used, const char* format, ...)
+{
+	if(used + kMaxTextItem > kTextBufferSize)
+	{
+		outStream.write(buffer, used);
+		used = 0;
+	}
+
+	va_list args;
+
+	va_start(args, format);
+	used += NNetLocale::formatTextList(buffer + used, kTextBufferSize - used, format, args);
+	va_end(args);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// appends weights to a binary network in the given storage type
+/// </summary>
+/// <param name="data">the binary network</param>
+/// <param name="weights">the weights</param>
+/// <param name="count">the number of weights</param>
+/// <param name="scalarType">the type to store the weights as</param>
+/// 
+static void writeWeights(vector<char>& data, const double* weights, size_t count, ScalarT scalarType)
+{
+	if(scalarType == kFloat64)
+	{
+		NNetBinaryFormat::putValues(data, weights, 8, count);
+	}
+	else
+	{
+		vector<unsigned short> halves(count);
+
+		for(size_t i = 0; i < count; i++)
+		{
+			halves[i] = (scalarType == kFloat16) ? NNetHalf::toFloat16(weights[i]) : 
+												   NNetHalf::toBFloat16(weights[i]);
+		}
+
+		NNetBinaryFormat::putValues(data, halves.data(), 2, count);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// reads weights stored in the given type from a binary network
+/// </summary>
+/// <param name="data">the binary network</param>
+/// <param name="length">the length of the binary network</param>
+/// <param name="pos">the position of the weights</param>
+/// <param name="weights">receives the weights</param>
+/// <param name="count">the number of weights</param>
+/// <param name="scalarType">the type the weights are stored as</param>
+/// 
+static void readWeights(const char* data, size_t length, size_t pos, double* weights, 
+					   size_t count, ScalarT scalarType)
+{
+	if(scalarType == kFloat64)
+	{
+		NNetBinaryFormat::getValues(data, length, pos, weights, 8, count);
+	}
+	else
+	{
+		vector<unsigned short> halves(count);
+
+		NNetBinaryFormat::getValues(data, length, pos, halves.data(), 2, count);
+
+		for(size_t i = 0; i < count; i++)
+		{
+			weights[i] = (scalarType == kFloat16) ? NNetHalf::fromFloat16(halves[i]) : 
+													NNetHalf::fromBFloat16(halves[i]);
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// appends the connection mask of a pruned layer to a binary network - 
+/// one bit for each connection, the lowest bit of each byte first
+/// </summary>
+/// <param name="data">the binary network</param>
+/// <param name="mask">true for each connection (row by row) that remains</param>
+/// 
+static void writeMask(vector<char>& data, const vector<bool>& mask)
+{
+	vector<unsigned char> bits((mask.size() + 7) / 8, 0);
+
+	for(size_t i = 0; i < mask.size(); i++)
+	{
+		if(mask[i])
+		{
+			bits[i / 8] |= (unsigned char)(1 << (i % 8));
+		}
+	}
+
+	NNetBinaryFormat::putValues(data, bits.data(), 1, bits.size());
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// reads the connection mask of a pruned layer from a binary network
+/// </summary>
+/// <param name="data">the binary network</param>
+/// <param name="pos">the position of the mask</param>
+/// <param name="mask">receives true for each connection (row by row) that remains</param>
+/// <param name="count">the number of connections</param>
+/// 
+static void readMask(const char* data, size_t pos, vector<bool>& mask, size_t count)
+{
+	const unsigned char* bits = reinterpret_cast<const unsigned char*>(data + pos);
+
+	mask.resize(count);
+
+	for(size_t i = 0; i < count; i++)
+	{
+		mask[i] = ((bits[i / 8] >> (i % 8)) & 1) != 0;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// waits for each of the given threads that is still running to finish
+/// </summary>
+/// <param name="workers">the threads</param>
+/// 
+static void joinThreads(vector<thread>& workers)
+{
+	for(int i = 0; i < (int)workers.size(); i++)
+	{
+		if(workers[i].joinable())
+		{
+			workers[i].join();
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// default constructor
+/// </summary>
+/// 
+NeuralNet::NeuralNet()
+{
+	mNumInputs = 0;
+	mNumOutputs = 0;
+	mNumLayers = 0;
+
+	// default output unit settings
+	mOutUnitType = kThreshold;
+	mOutUnitSlope = 1.0;
+	mOutUnitAmplify = 1.0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// constructs a NeuralNet object from a file containing a network in 
+/// serialized form - either the text form written by writeToFile or
+/// the binary form written by writeToBinaryFile
+/// </summary>
+/// <param name="fname">the file containing the serialized data</param>
+/// 
+NeuralNet::NeuralNet(const string& fname)
+{
+	clearNeuralNetwork();
+
+	ifstream inFile(fname, ios::binary);
+
+	if(inFile.good())
+	{		
+		// find the length of the file
+		inFile.seekg (0, inFile.end);
+		int length = (int)inFile.tellg();
+		inFile.seekg (0, inFile.beg);
+
+		if(length > 0)
+		{
+			// read the data straight into a suitably sized (and terminated) string
+			string buffer(length, '\0');
+
+			inFile.read(&buffer[0], length);
+
+			// instantiate the network - binary files start with a tag
+			int result = NNetBinaryFormat::hasTag(buffer.data(), length) ? 
+						 deserializeBinary(buffer.data(), length) : deserialize(buffer);
+
+			if(result != 0)
+			{
+				cerr << "Error deserializing!" << endl;
+			}
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// copy constructor - the copy gathers the copied weights into a 
+/// weight block of its own
+/// </summary>
+/// <param name="other">the network to be copied</param>
+/// 
+NeuralNet::NeuralNet(const NeuralNet& other)
+	: mNumInputs(other.mNumInputs), mNumOutputs(other.mNumOutputs), mNumLayers(other.mNumLayers),
+	  mOutUnitType(other.mOutUnitType), mOutUnitSlope(other.mOutUnitSlope), mOutUnitAmplify(other.mOutUnitAmplify),
+	  mLayers(other.mLayers), mWorkspace(other.mWorkspace), mActiveUnits(other.mActiveUnits),
+	  mActiveSlope(other.mActiveSlope), mActiveAmplify(other.mActiveAmplify)
+{
+	packWeights();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// move constructor - the layers are taken over rather than copied 
+/// and the other network is left empty
+/// </summary>
+/// <param name="other">the network whose layers are taken over</param>
+/// 
+NeuralNet::NeuralNet(NeuralNet&& other) noexcept
+	: mNumInputs(other.mNumInputs), mNumOutputs(other.mNumOutputs), mNumLayers(other.mNumLayers),
+	  mOutUnitType(other.mOutUnitType), mOutUnitSlope(other.mOutUnitSlope), mOutUnitAmplify(other.mOutUnitAmplify),
+	  mLayers(move(other.mLayers)), mWeights(move(other.mWeights)), mWeightOffsets(move(other.mWeightOffsets)),
+	  mWorkspace(move(other.mWorkspace)), mActiveUnits(move(other.mActiveUnits)),
+	  mActiveSlope(move(other.mActiveSlope)), mActiveAmplify(move(other.mActiveAmplify))
+{
+	other.clearNeuralNetwork();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// destructor
+/// </summary>
+///
+NeuralNet::~NeuralNet()
+{
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// copy assignment - this network gathers the copied weights into a 
+/// weight block of its own
+/// </summary>
+/// <param name="other">the network to be copied</param>
+/// <returns>this network</returns>
+/// 
+NeuralNet& NeuralNet::operator=(const NeuralNet& other)
+{
+	if(this != &other)
+	{
+		mNumInputs = other.mNumInputs;
+		mNumOutputs = other.mNumOutputs;
+		mNumLayers = other.mNumLayers;
+		mOutUnitType = other.mOutUnitType;
+		mOutUnitSlope = other.mOutUnitSlope;
+		mOutUnitAmplify = other.mOutUnitAmplify;
+
+		mLayers = other.mLayers;
+		mWorkspace = other.mWorkspace;
+		mActiveUnits = other.mActiveUnits;
+		mActiveSlope = other.mActiveSlope;
+		mActiveAmplify = other.mActiveAmplify;
+
+		packWeights();
+	}
+
+	return *this;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// move assignment - the layers are taken over rather than copied and
+/// the other network is left empty
+/// </summary>
+/// <param name="other">the network whose layers are taken over</param>
+/// <returns>this network</returns>
+/// 
+NeuralNet& NeuralNet::operator=(NeuralNet&& other) noexcept
+{
+	if(this != &other)
+	{
+		mNumInputs = other.mNumInputs;
+		mNumOutputs = other.mNumOutputs;
+		mNumLayers = other.mNumLayers;
+		mOutUnitType = other.mOutUnitType;
+		mOutUnitSlope = other.mOutUnitSlope;
+		mOutUnitAmplify = other.mOutUnitAmplify;
+
+		mLayers = move(other.mLayers);
+		mWeights = move(other.mWeights);
+		mWeightOffsets = move(other.mWeightOffsets);
+		mWorkspace = move(other.mWorkspace);
+		mActiveUnits = move(other.mActiveUnits);
+		mActiveSlope = move(other.mActiveSlope);
+		mActiveAmplify = move(other.mActiveAmplify);
+
+		other.clearNeuralNetwork();
+	}
+
+	return *this;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Public Methods
+/////////////////////////////////////////////////////////////////////
+
+/// <summary>
+/// clears a NeuralNet object ready for re-use
+/// </summary>
+/// 
+void NeuralNet::clearNeuralNetwork()
+{
+	mNumInputs = 0;
+	mNumOutputs = 0;
+	mNumLayers = 0;
+	mOutUnitType = kThreshold;
+	mOutUnitSlope = 1;
+	mOutUnitAmplify = 1;
+
+	mLayers.clear();
+	mWeights.clear();
+	mWeightOffsets.clear();
+	mWorkspace.clearWorkspace();
+	mActiveUnits.clear();
+	mActiveSlope.clear();
+	mActiveAmplify.clear();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets the number of input units
+/// </summary>
+/// <param name="numInputs">the number of input units</param>
+///
+void NeuralNet::setNumInputs(int numInputs)
+{
+	// ignore invalid values
+	if(numInputs > 0)
+	{
+		mNumInputs = numInputs;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets the number of output units
+/// </summary>
+/// <param name="numOutputs">the number of output units</param>
+///
+void NeuralNet::setNumOutputs(int numOutputs)
+{
+	// ignore invalid values
+	if(numOutputs > 0)
+	{
+		mNumOutputs = numOutputs;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets the output layer units activation function type
+/// </summary>
+/// <param name="unitType">the activation function type</param>
+///
+void NeuralNet::setOutputUnitType(ActiveT unitType)
+{
+	mOutUnitType = unitType;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets the output layer units activation function slope value
+/// </summary>
+/// <param name="slope">the slope value for the activation function</param>
+///
+void NeuralNet::setOutputUnitSlope(double slope)
+{
+	// ignore invalid values
+	if(slope > 0)
+	{
+		mOutUnitSlope = slope;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets the output layer units activation function amplify value
+/// </summary>
+/// <param name="amplify">the amplify value for the activation function</param>
+///
+void NeuralNet::setOutputUnitAmplify(double amplify)
+{
+	// ignore invalid values
+	if(amplify > 0)
+	{
+		mOutUnitAmplify = amplify;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// adds a new hidden layer - 
+/// 
+/// The hidden layers are stored in the order of calls to this method
+/// so the first call to addlayer creates the first hidden layer, the
+/// second call creates the second layer and so on.
+/// </summary>
+/// <param name="numUnits">the number of units in the hidden layer</param>
+/// <param name="unitType">the layer unit activation function type 
+///                        (defaults to unipolar)</param>
+/// <param name="initRange">the range of the initial weighted connection
+///                         values (defaults to 2 coressponding to -1 to +1)</param>
+/// <param name="slope">the layer unit activation function slope value 
+///                     (defaults to 1.0)</param>
+/// <param name="amplify">the layer unit activation function amplify 
+///                       value (defaults to 1.0)</param>
+///
+/// <returns>0 if the layer is successfully added otherwise -1</returns>
+/// 
+int NeuralNet::addLayer(int numUnits, ActiveT unitType, double initRange, double slope, double amplify)
+{
+	NNetWeightedConnect connect, output;
+
+	// ignore invalid values
+	if(numUnits > 0 && initRange > 0 && slope > 0 && amplify > 0)
+	{
+		if(mNumLayers == 0)
+		{
+			// configure the first hidden layer
+			if(mNumInputs > 0)
+			{
+				// set up the weighted connections between the input and the first layer
+				// the weighted connections are initialised with random values in the
+				// range: -(initRange / 2) to +(initRange / 2)
+				connect.setNumNodes(mNumInputs, numUnits, initRange);
+
+				// store the unit type for the layer
+				mActiveUnits.push_back(unitType);
+
+				// store the steepness of the activation function's slope
+				mActiveSlope.push_back(slope);
+
+				// store the amplification factor of the activation function
+				mActiveAmplify.push_back(amplify);
+
+				mNumLayers++;			
+			}
+			else
+			{
+				return -1;
+			}
+		}
+		else
+		{		
+			// configure subsequent hidden layers
+			if(mNumLayers > 0)
+			{
+				int nInputs = mLayers[mNumLayers - 1].getNumOutputNodes();
+
+				// set up the weighted connections between the previous layer and the new one
+				// the weighted connections are initialised with random values in the
+				// range: -(initRange / 2) to +(initRange / 2)
+				connect.setNumNodes(nInputs, numUnits, initRange);
+
+				// store the unit type for the layer
+				mActiveUnits.push_back(unitType);
+
+				// store the steepness of the activation function's slope
+				mActiveSlope.push_back(slope);
+
+				// store the amplification factor of the activation function
+				mActiveAmplify.push_back(amplify);
+
+				mNumLayers++;
+			}
+			else
+			{
+				return -1;
+			}
+		}
+
+		// connect the last hidden layer to the output layer
+		if(mNumLayers > 1)
+		{
+			// overwrite the old output connections
+			mLayers[mNumLayers - 1] = connect;
+		}
+		else
+		{
+			// add the connections for the first layer
+			mLayers.push_back(connect);
+		}
+
+		// set up the weighted connections between the last layer and the output
+		output.setNumNodes(numUnits, mNumOutputs, initRange);
+
+		// add the output connections
+		mLayers.push_back(output);
+
+		packWeights();
+	}
+	else
+	{
+		return -1;
+	}
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the details of the specified hidden layer
+/// </summary>
+/// <param name="n">the specified hidden layer index</param>
+/// <param name="unitType">the layer unit activation function type</param>
+/// <param name="slope">the layer unit activation function slope value</param>
+/// <param name="amplify">the layer unit activation function amplify value</param>
+/// 
+void NeuralNet::getLayerDetails(int n, ActiveT& unitType, double& slope, double& amplify) const
+{
+	if(n >= 0 && n < mNumLayers)
+	{
+		unitType = mActiveUnits[n];
+		slope = mActiveSlope[n];
+		amplify = mActiveAmplify[n];
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the response of the network to the given input - 
+/// 
+/// The number of elements in the inputs vector should correspond to 
+/// the number of the input units.  If the inputs vector contains 
+/// more elements than this, the additional input values are ignored.
+/// 
+/// The activation and unit input values calculated along the way are 
+/// kept by the network so the training process can inspect them via
+/// getActivations and getUnitInputs.
+/// </summary>
+/// <param name="inputs">the network input values</param>
+/// <param name="outputs">the network output values</param>
+/// 
+void NeuralNet::getResponse(const vector<double>& inputs, vector<double>& outputs)
+{
+	getResponse(inputs, outputs, mWorkspace);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the response of the network to the given input using the 
+/// caller's workspace - 
+/// 
+/// This method does not modify the network so a single trained 
+/// network can be shared by any number of threads provided each 
+/// thread supplies its own workspace.
+/// 
+/// The weighted connections are applied in place and the unit input 
+/// and activation values are written into the workspace arena which
+/// is laid out on the first call, so once a workspace has been used no
+/// further memory is allocated (provided the outputs vector is reused).
+/// </summary>
+/// <param name="inputs">the network input values</param>
+/// <param name="outputs">the network output values</param>
+/// <param name="workspace">receives the layer activation and unit input values</param>
+/// 
+void NeuralNet::getResponse(const vector<double>& inputs, vector<double>& outputs,
+							NNetWorkspace& workspace) const
+{
+	if((int)inputs.size() >= mNumInputs && mNumLayers > 0)
+	{
+		// lay out the workspace arena - this only allocates on the first call
+		workspace.setNumLayers(mNumLayers + 1);
+
+		for(int i = 0; i <= mNumLayers; i++)	// use <= to include the output layer
+		{
+			workspace.setLayerSize(i, mLayers[i].getNumOutputNodes());
+		}
+
+		workspace.layoutLayers();
+
+		// the input layer values feed the first set of weighted connections
+		const double* layerInputs = inputs.data();
+
+		// propagate the data through the network
+		for(int i = 0; i <= mNumLayers; i++)	// use <= to include the output layer
+		{
+			const NNetWeightedConnect& connect = mLayers[i];
+			int nUnits = connect.getNumOutputNodes();
+
+			double* unitInputs = workspace.getUnitInputs(i);
+			double* activations = workspace.getActivations(i);
+
+			// apply the weighted connections - this gives the unit input values
+			connect.getOutputs(layerInputs, unitInputs);
+
+			// activate the net units
+			activateLayer(i, unitInputs, activations, nUnits);
+
+			// the activations are the inputs to the next layer
+			layerInputs = activations;
+		}
+	
+		// copy the results into the output vector
+		const double* outActivations = workspace.getActivations(mNumLayers);
+
+		outputs.assign(outActivations, outActivations + workspace.getLayerSize(mNumLayers));
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the responses of the network to a batch of input rows - 
+/// 
+/// The inputs vector holds the input rows one after another, each row
+/// containing one value for every input unit, and the outputs vector is
+/// resized to hold the corresponding output rows. See the pointer based
+/// overload for details of how the rows are processed.
+/// </summary>
+/// <param name="inputs">the network input rows</param>
+/// <param name="outputs">the network output rows</param>
+/// <param name="numThreads">the number of threads to use (0 uses all the 
+///                          available hardware threads)</param>
+/// 
+void NeuralNet::getResponses(const vector<double>& inputs, vector<double>& outputs, int numThreads) const
+{
+	if(mNumInputs > 0 && mNumLayers > 0)
+	{
+		int numRows = (int)inputs.size() / mNumInputs;
+
+		outputs.resize(numRows * mNumOutputs);
+
+		if(numRows > 0)
+		{
+			getResponses(inputs.data(), outputs.data(), numRows, numThreads);
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the responses of the network to a batch of input rows - 
+/// 
+/// The input matrix is stored row by row with one value for each input
+/// unit and the output matrix, which must be large enough to hold one
+/// value for each output unit per row, is filled in the same order. 
+/// 
+/// The rows are divided into contiguous ranges that are scored in
+/// parallel, each thread pushing small blocks of rows through the
+/// network one layer at a time. The network itself is only read so
+/// the per-sample activation buffers used by getResponse (and hence by
+/// the trainer) are left untouched.
+/// </summary>
+/// <param name="inputs">the network input rows</param>
+/// <param name="outputs">the network output rows</param>
+/// <param name="numRows">the number of rows</param>
+/// <param name="numThreads">the number of threads to use (0 uses all the 
+///                          available hardware threads)</param>
+/// 
+void NeuralNet::getResponses(const double* inputs, double* outputs, int numRows, int numThreads) const
+{
+	if(mNumInputs <= 0 || mNumLayers <= 0 || numRows <= 0)
+	{
+		return;
+	}
+
+	if(numThreads <= 0)
+	{
+		numThreads = max((int)thread::hardware_concurrency(), 1);
+	}
+
+	// don't split small batches - the threads would cost more than they save
+	numThreads = min(numThreads, max(numRows / kMinRowsPerThread, 1));
+
+	vector<thread> workers;
+	int rowsPerThread = numRows / numThreads;
+	int extraRows = numRows % numThreads;
+	int firstRow = 0;
+
+	workers.reserve(numThreads - 1);
+
+	try
+	{
+		// hand each worker a contiguous range of rows
+		for(int i = 0; i < numThreads; i++)
+		{
+			int nRows = rowsPerThread + (i < extraRows ? 1 : 0);
+			const double* rangeInputs = inputs + (size_t)firstRow * mNumInputs;
+			double* rangeOutputs = outputs + (size_t)firstRow * mNumOutputs;
+
+			if(i < numThreads - 1)
+			{
+				workers.push_back(thread(&NeuralNet::getRangeResponses, this, rangeInputs, rangeOutputs, nRows));
+			}
+			else
+			{
+				// the calling thread scores the last range itself
+				getRangeResponses(rangeInputs, rangeOutputs, nRows);
+			}
+
+			firstRow += nRows;
+		}
+	}
+	catch(...)
+	{
+		// a thread that is still joinable when destroyed terminates the
+		// program, so wait for the workers already started before passing
+		// the exception on
+		joinThreads(workers);
+		throw;
+	}
+
+	joinThreads(workers);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the responses of the network to a batch of input rows 
+/// evaluating each distinct row only once - 
+/// 
+/// Real predictor columns often contain many repeated values (e.g. the
+/// age column of the Wage dataset has around 60 distinct values in 3000
+/// rows). The row indices are sorted so that identical rows are next to
+/// each other, the distinct rows are scored with getResponses and the
+/// results are then copied back to every row that shares the input.
+/// Rows are only treated as identical if their values match bit for
+/// bit, so the outputs are exactly those of getResponses.
+/// </summary>
+/// <param name="inputs">the network input rows</param>
+/// <param name="outputs">the network output rows</param>
+/// <param name="numThreads">the number of threads to use (0 uses all the 
+///                          available hardware threads)</param>
+/// 
+void NeuralNet::getDistinctResponses(const vector<double>& inputs, vector<double>& outputs, int numThreads) const
+{
+	if(mNumInputs <= 0 || mNumLayers <= 0)
+	{
+		return;
+	}
+
+	int numRows = (int)inputs.size() / mNumInputs;
+	int nIn = mNumInputs;
+	const double* rows = inputs.data();
+
+	// compares rows by the bit patterns of their values - unlike comparing
+	// the values themselves this gives a valid ordering even for NaNs
+	struct RowLess
+	{
+		const double* rows;
+		int nIn;
+
+		bool operator()(int a, int b) const
+		{
+			return memcmp(rows + (size_t)a * nIn, rows + (size_t)b * nIn, nIn * sizeof(double)) < 0;
+		}
+	};
+
+	RowLess rowLess = { rows, nIn };
+	vector<int> order(numRows);
+
+	for(int i = 0; i < numRows; i++)
+	{
+		order[i] = i;
+	}
+
+	sort(order.begin(), order.end(), rowLess);
+
+	// gather the distinct rows and note which distinct row each row maps to
+	vector<double> distinctInputs, distinctOutputs;
+	vector<int> distinctIdx(numRows);
+	int nDistinct = 0;
+
+	for(int i = 0; i < numRows; i++)
+	{
+		if(i == 0 || rowLess(order[i - 1], order[i]))
+		{
+			const double* row = rows + (size_t)order[i] * nIn;
+
+			distinctInputs.insert(distinctInputs.end(), row, row + nIn);
+			nDistinct++;
+		}
+
+		distinctIdx[order[i]] = nDistinct - 1;
+	}
+
+	getResponses(distinctInputs, distinctOutputs, numThreads);
+
+	// scatter the results back to the original rows
+	outputs.resize((size_t)numRows * mNumOutputs);
+
+	for(int i = 0; i < numRows; i++)
+	{
+		copy(distinctOutputs.begin() + (size_t)distinctIdx[i] * mNumOutputs,
+			 distinctOutputs.begin() + (size_t)(distinctIdx[i] + 1) * mNumOutputs,
+			 outputs.begin() + (size_t)i * mNumOutputs);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// produces a compact read only copy of this network that is 
+/// optimised for calculating responses (see NNetFrozen.cpp)
+/// </summary>
+/// <returns>the frozen network</returns>
+/// 
+NNetFrozen NeuralNet::freeze() const
+{
+	return freeze(vector<ScalarT>());
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// produces a compact read only copy of this network with the weights
+/// of each layer stored as the given type (see NNetFrozen.cpp)
+/// </summary>
+/// <param name="layerScalars">the storage type of each layer (the hidden layers 
+///                            followed by the output layer) - layers without 
+///                            a type are stored as doubles</param>
+/// <returns>the frozen network</returns>
+/// 
+NNetFrozen NeuralNet::freeze(const vector<ScalarT>& layerScalars) const
+{
+	NNetFrozen frozen;
+
+	frozen.setNumInputs(mNumInputs);
+
+	for(int i = 0; i <= mNumLayers; i++)		// use <= to include the output layer
+	{
+		ScalarT scalarType = (i < (int)layerScalars.size()) ? layerScalars[i] : kFloat64;
+
+		if(i < mNumLayers)
+		{
+			frozen.addLayer(mLayers[i], mActiveUnits[i], mActiveSlope[i], mActiveAmplify[i], scalarType);
+		}
+		else
+		{
+			frozen.addLayer(mLayers[i], mOutUnitType, mOutUnitSlope, mOutUnitAmplify, scalarType);
+		}
+	}
+
+	return frozen;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the activation values for a specified layer - 
+/// 
+/// This method is typically called by the training process to access
+/// the activation values of the hidden and output layers.
+/// </summary>
+/// <param name="activations">the activation values for the layer</param>
+/// <param name="layer">the specified layer</param>
+/// 
+void NeuralNet::getActivations(vector<double>& activations, int layer) const
+{
+	if(layer >= 0 && layer < mWorkspace.getNumLayers())
+	{
+		const double* values = mWorkspace.getActivations(layer);
+
+		activations.assign(values, values + mWorkspace.getLayerSize(layer));
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the unit input values for a specified layer - 
+/// 
+/// This method is typically called by the training process to access
+/// the input values to the hidden and output layer activation functions.
+/// </summary>
+/// <param name="inputs">the unit input values for the layer</param>
+/// <param name="layer">the specified layer</param>
+/// 
+void NeuralNet::getUnitInputs(vector<double>& inputs, int layer) const
+{
+	if(layer >= 0 && layer < mWorkspace.getNumLayers())
+	{
+		const double* values = mWorkspace.getUnitInputs(layer);
+
+		inputs.assign(values, values + mWorkspace.getLayerSize(layer));
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the weighted connections for a specified layer - 
+/// 
+/// This method is typically called by the training process to access 
+/// the weighted connections.
+/// </summary>
+/// <param name="wtConnect">the weighted connections between the 
+///                         specified layer and the next sequential
+///                         layer in the network.</param>
+/// <param name="layer">the specified layer</param>
+/// 
+void NeuralNet::getWeightedConnect(NNetWeightedConnect& wtConnect, int layer) const
+{
+	if(layer >= 0 && layer < (int)mLayers.size())
+	{
+		wtConnect = mLayers[layer];
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// sets the weighted connections for a specified layer - 
+/// 
+/// This method is typically called by the training process to update 
+/// the weighted connections.
+/// </summary>
+/// <param name="wtConnect">the weighted connections between the 
+///                         specified layer and the next sequential 
+///                         layer in the network</param>
+/// <param name="layer">the specified layer</param>
+/// 
+void NeuralNet::setWeightedConnect(const NNetWeightedConnect& wtConnect, int layer)
+{
+	if(layer >= 0 && layer < (int)mLayers.size())
+	{
+		mLayers[layer] = wtConnect;
+
+		// a connection storing a different number of weights needs a new block
+		if(!mLayers[layer].hasSharedWeights())
+		{
+			packWeights();
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the total number of stored weighted connections - the pruned 
+/// connections are not included
+/// </summary>
+/// <returns>the number of weighted connections</returns>
+/// 
+int NeuralNet::getNumWeights() const
+{
+	int numWeights = 0;
+
+	for(int i = 0; i < (int)mLayers.size(); i++)
+	{
+		numWeights += mLayers[i].getNumConnections();
+	}
+
+	return numWeights;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// checks whether another network has the same topology and activation
+/// settings - the numbers of units in each layer, the activation types, 
+/// slope and amplify values and the connections remaining after any 
+/// pruning must all match. The weights themselves are not compared so 
+/// either network's weights can be restored into the other with 
+/// setWeights.
+/// </summary>
+/// <param name="other">the other network</param>
+/// <returns>true if the networks differ only in their weights</returns>
+/// 
+bool NeuralNet::hasSameTopology(const NeuralNet& other) const
+{
+	if(mNumInputs != other.mNumInputs || mNumOutputs != other.mNumOutputs ||
+	   mNumLayers != other.mNumLayers || mLayers.size() != other.mLayers.size() ||
+	   mOutUnitType != other.mOutUnitType || mOutUnitSlope != other.mOutUnitSlope ||
+	   mOutUnitAmplify != other.mOutUnitAmplify || mActiveUnits != other.mActiveUnits ||
+	   mActiveSlope != other.mActiveSlope || mActiveAmplify != other.mActiveAmplify)
+	{
+		return false;
+	}
+
+	for(int i = 0; i < (int)mLayers.size(); i++)
+	{
+		if(!mLayers[i].hasSameConnections(other.mLayers[i]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// copies every weighted connection of the network into a single 
+/// block - 
+/// 
+/// The layers are stored one after another just as they are held in
+/// the network's weight block, so taking a snapshot of the network's
+/// parameters is a single block copy (or one copy per layer if a 
+/// layer has been taken out of the block - see packWeights). The 
+/// snapshot can be restored with setWeights provided the topology 
+/// (and any pruning) of the network has not changed.
+/// </summary>
+/// <param name="weights">receives the weighted connections</param>
+/// 
+void NeuralNet::getWeights(vector<double>& weights) const
+{
+	if(hasPackedWeights())
+	{
+		weights.assign(mWeights.begin(), mWeights.end());
+		return;
+	}
+
+	weights.resize(getNumWeights());
+
+	double* block = weights.data();
+
+	for(int i = 0; i < (int)mLayers.size(); i++)
+	{
+		int n = mLayers[i].getNumConnections();
+
+		copy(mLayers[i].getWeightData(), mLayers[i].getWeightData() + n, block);
+		block += n;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// restores every weighted connection of the network from a single 
+/// block produced by getWeights
+/// </summary>
+/// <param name="weights">the weighted connections</param>
+/// <returns>0 if successful otherwise -1 (the block does not match the network)</returns>
+/// 
+int NeuralNet::setWeights(const vector<double>& weights)
+{
+	if((int)weights.size() != getNumWeights())
+	{
+		return -1;
+	}
+
+	if(hasPackedWeights())
+	{
+		copy(weights.begin(), weights.end(), mWeights.begin());
+		return 0;
+	}
+
+	const double* block = weights.data();
+
+	for(int i = 0; i < (int)mLayers.size(); i++)
+	{
+		int n = mLayers[i].getNumConnections();
+
+		copy(block, block + n, mLayers[i].getWeightData());
+		block += n;
+	}
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gathers the weighted connections of every layer into the network's
+/// weight block - 
+/// 
+/// The network does this itself whenever it builds or changes its 
+/// layers. Anything that changes the number of weights a layer stores
+/// through getWeightedConnect (such as pruning or making a layer dense
+/// again) takes that layer out of the block, so this should be called
+/// afterwards to bring the layers back together.
+/// </summary>
+/// 
+void NeuralNet::packWeights()
+{
+	vector<double> weights;
+	vector<size_t> offsets(1, 0);
+
+	for(int i = 0; i < (int)mLayers.size(); i++)
+	{
+		offsets.push_back(offsets.back() + mLayers[i].getNumConnections());
+	}
+
+	weights.resize(offsets.back());
+
+	// each layer copies its weights into the new block from wherever they are held now
+	for(int i = 0; i < (int)mLayers.size(); i++)
+	{
+		mLayers[i].shareWeights(weights.data() + offsets[i]);
+	}
+
+	// swapping keeps the block where the layers now expect it
+	mWeights.swap(weights);
+	mWeightOffsets.swap(offsets);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// serializes this network and writes it to a file - the data is 
+/// written to a temporary file which then replaces the file
+/// </summary>
+/// <param name="fname">the file to write the data to</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NeuralNet::writeToFile(const string& fname) const
+{
+	// write to a temporary file first so the file is never seen incomplete
+	string tempName = fname + ".tmp";
+	bool written = false;
+
+	{
+		ofstream outFile(tempName);
+
+		if(outFile.good())
+		{
+			serialize(outFile);
+			outFile.close();
+			written = !outFile.fail();
+		}
+	}
+
+	if(written && NNetBinaryFormat::replaceFile(tempName, fname) == 0)
+	{
+		return 0;
+	}
+
+	remove(tempName.c_str());
+
+	return -1;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// writes the network to a file in binary form - see the notes at the
+/// top of this file for the layout
+/// </summary>
+/// <param name="fname">the file to write the data to</param>
+/// <param name="scalarType">the type to store the weights of every layer as</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NeuralNet::writeToBinaryFile(const string& fname, ScalarT scalarType) const
+{
+	return writeToBinaryFile(fname, vector<ScalarT>(mNumLayers + 1, scalarType));
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// writes the network to a file in binary form with the weights of 
+/// each layer stored as the given type - layers that are sensitive to
+/// rounding can be kept in double precision
+/// 
+/// The data is written to a temporary file which then replaces the 
+/// file, so a network mapped from the file keeps the old weights.
+/// </summary>
+/// <param name="fname">the file to write the data to</param>
+/// <param name="layerScalars">the storage type of each layer (the hidden layers 
+///                            followed by the output layer) - layers without 
+///                            a type are stored as doubles</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NeuralNet::writeToBinaryFile(const string& fname, const vector<ScalarT>& layerScalars) const
+{
+	vector<char> data;
+
+	if(mNumLayers < 1)
+	{
+		return -1;
+	}
+
+	serializeBinary(data, layerScalars);
+
+	// the file replaces any existing file in one step as it may be mapped (see NNetFrozen::openMapped)
+	return NNetBinaryFormat::writeFile(fname, data);
+}
+
+/////////////////////////////////////////////////////////////////////
+// Private Methods
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// checks whether every layer holds its weights in the network's 
+/// weight block, at the position given by the offset table
+/// </summary>
+/// <returns>true if the weight block holds the weights of every layer</returns>
+/// 
+bool NeuralNet::hasPackedWeights() const
+{
+	if(mWeightOffsets.size() != mLayers.size() + 1)
+	{
+		return false;
+	}
+
+	for(int i = 0; i < (int)mLayers.size(); i++)
+	{
+		const NNetWeightedConnect& connect = mLayers[i];
+
+		if(!connect.hasSharedWeights() || connect.getWeightData() != mWeights.data() + mWeightOffsets[i] ||
+		   (size_t)connect.getNumConnections() != mWeightOffsets[i + 1] - mWeightOffsets[i])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// applies the activation function of the specified layer to an array 
+/// of unit input values
+/// </summary>
+/// <param name="layer">the specified layer (mNumLayers is the output layer)</param>
+/// <param name="unitInputs">the unit input values</param>
+/// <param name="activations">the activation values (may be the unit input array)</param>
+/// <param name="n">the number of values</param>
+/// 
+void NeuralNet::activateLayer(int layer, const double* unitInputs, double* activations, int n) const
+{
+	if(layer < mNumLayers)
+	{
+		// a hidden layer
+		NNetUnit::getActivationFunction(mActiveUnits[layer])(unitInputs, activations, n, 
+															  mActiveSlope[layer], mActiveAmplify[layer]);
+	}
+	else
+	{
+		// the output layer
+		NNetUnit::getActivationFunction(mOutUnitType)(unitInputs, activations, n, 
+													   mOutUnitSlope, mOutUnitAmplify);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the responses of the network to a contiguous range of input 
+/// rows - the range is processed in small blocks so the intermediate 
+/// layer values stay in the cache
+/// </summary>
+/// <param name="inputs">the network input rows</param>
+/// <param name="outputs">the network output rows</param>
+/// <param name="numRows">the number of rows in the range</param>
+/// 
+void NeuralNet::getRangeResponses(const double* inputs, double* outputs, int numRows) const
+{
+	vector<double> unitInputs;
+	vector<double> activations;
+
+	for(int i = 0; i < numRows; i += kBatchBlockRows)
+	{
+		int nRows = min(kBatchBlockRows, numRows - i);
+
+		getBlockResponses(inputs + (size_t)i * mNumInputs, outputs + (size_t)i * mNumOutputs,
+						  nRows, unitInputs, activations);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// gets the responses of the network to a small block of input rows - 
+/// 
+/// Each layer is applied to the whole block before moving on to the 
+/// next one. The two working buffers are supplied by the caller so
+/// they can be reused from block to block.
+/// </summary>
+/// <param name="inputs">the network input rows</param>
+/// <param name="outputs">the network output rows</param>
+/// <param name="numRows">the number of rows in the block</param>
+/// <param name="unitInputs">working buffer for the unit input values</param>
+/// <param name="activations">working buffer for the activation values</param>
+/// 
+void NeuralNet::getBlockResponses(const double* inputs, double* outputs, int numRows,
+								  vector<double>& unitInputs, vector<double>& activations) const
+{
+	const double* layerInputs = inputs;
+
+	for(int i = 0; i <= mNumLayers; i++)	// use <= to include the output layer
+	{
+		const NNetWeightedConnect& connect = mLayers[i];
+		int nValues = connect.getNumOutputNodes() * numRows;
+
+		if((int)unitInputs.size() < nValues) unitInputs.resize(nValues);
+
+		// apply the weighted connections to every row in the block
+		connect.getOutputs(layerInputs, unitInputs.data(), numRows);
+
+		// the output layer activations are written straight to the caller's buffer
+		double* layerOutputs = outputs;
+
+		if(i < mNumLayers)
+		{
+			if((int)activations.size() < nValues) activations.resize(nValues);
+
+			layerOutputs = activations.data();
+		}
+
+		// activate the net units
+		activateLayer(i, unitInputs.data(), layerOutputs, nValues);
+
+		layerInputs = layerOutputs;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// writes a string representation of this network to a stream - 
+/// 
+/// The text is formatted into a fixed size buffer which is written out
+/// whenever it fills, straight from the weighted connections, so the 
+/// memory used does not grow with the size of the network. Values are
+/// written with 17 significant digits so they are read back exactly.
+/// The details of a pruned layer are followed by a P and its pruned
+/// connections are written as an x.
+/// </summary>
+/// <param name="outStream">the stream to write to</param>
+/// 
+void NeuralNet::serialize(ostream& outStream) const
+{
+	vector<char> buffer(kTextBufferSize);
+	size_t used = 0;
+
+	// serialize the main details
+	writeText(outStream, buffer.data(), used, "%d %d %d %d %.17g %.17g ", mNumInputs, mNumOutputs, 
+			  mNumLayers, (int)mOutUnitType, mOutUnitSlope, mOutUnitAmplify);
+
+	// serialize the layer data
+	for(int i = 0; i <= mNumLayers; i++)		// use <= to include the output layer
+	{
+		const NNetWeightedConnect& connect = mLayers[i];
+		int nIn = connect.getNumInputNodes();
+		int nOut = connect.getNumOutputNodes();
+		int nUnit = 0;
+		double sUnit = 0.0, aUnit = 0.0;
+
+		// get the unit type, slope and amplification for the hidden layer
+		if(i < mNumLayers) nUnit = (int)mActiveUnits[i];
+		if(i < mNumLayers) sUnit = mActiveSlope[i];
+		if(i < mNumLayers) aUnit = mActiveAmplify[i];
+
+		writeText(outStream, buffer.data(), used, "L %d %d %d %.17g %.17g ", nIn, nOut, nUnit, sUnit, aUnit);
+
+		// a pruned layer is marked so its sparse storage can be restored
+		if(connect.isSparse())
+		{
+			writeText(outStream, buffer.data(), used, "P ");
+		}
+
+		for(int j = 0; j < nOut; j++)
+		{
+			const double* weights;
+			const int* inputNodes;
+			int numWeights = connect.getRowWeights(j, weights, inputNodes);
+			int next = 0;
+
+			// pruned connections are written as an x
+			for(int k = 0; k < nIn; k++)
+			{
+				if(inputNodes == NULL || (next < numWeights && inputNodes[next] == k))
+				{
+					writeText(outStream, buffer.data(), used, "%.17g ", weights[next++]);
+				}
+				else
+				{
+					writeText(outStream, buffer.data(), used, "x ");
+				}
+			}
+		}
+	}
+
+	// terminate the output
+	writeText(outStream, buffer.data(), used, "\n");
+
+	outStream.write(buffer.data(), used);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// generates a binary representation of this network - the weighted
+/// connections of an unpruned layer held as doubles are copied as a 
+/// single block
+/// </summary>
+/// <param name="outData">receives the binary representation</param>
+/// <param name="layerScalars">the storage type of each layer - layers without a type are stored as doubles</param>
+/// 
+void NeuralNet::serializeBinary(vector<char>& outData, const vector<ScalarT>& layerScalars) const
+{
+	unsigned int version = NNetBinaryFormat::kFirstVersion;
+	unsigned int scalarType = NNetBinaryFormat::kScalarFloat64;
+	int details[4] = { mNumInputs, mNumOutputs, mNumLayers, (int)mOutUnitType };
+	double outDetails[2] = { mOutUnitSlope, mOutUnitAmplify };
+	size_t length = NNetBinaryFormat::kHeaderSize + NNetBinaryFormat::kChecksumSize;
+	vector<ScalarT> scalars(mNumLayers + 1, kFloat64);
+
+	// size the buffer up front so the weights are only copied once
+	for(int i = 0; i <= mNumLayers; i++)		// use <= to include the output layer
+	{
+		if(i < (int)layerScalars.size())
+		{
+			scalars[i] = layerScalars[i];
+		}
+
+		size_t numWeights = (size_t)mLayers[i].getNumInputNodes() * mLayers[i].getNumOutputNodes();
+
+		// only files holding 16 bit weights or pruned layers need the later versions
+		if(scalars[i] != kFloat64 && version < NNetBinaryFormat::kHalfVersion)
+		{
+			version = NNetBinaryFormat::kHalfVersion;
+		}
+
+		if(mLayers[i].isSparse())
+		{
+			version = NNetBinaryFormat::kMaskVersion;
+			length += NNetBinaryFormat::getMaskBlockSize(numWeights);
+		}
+
+		length += NNetBinaryFormat::kLayerRecordSize + NNetBinaryFormat::getWeightBlockSize(numWeights, scalars[i]);
+	}
+
+	outData.clear();
+	outData.reserve(length);
+
+	// the header
+	NNetBinaryFormat::putValues(outData, NNetBinaryFormat::kTag, 1, sizeof(NNetBinaryFormat::kTag));
+	NNetBinaryFormat::putValues(outData, &version, 4, 1);
+	NNetBinaryFormat::putValues(outData, &scalarType, 4, 1);
+	NNetBinaryFormat::putValues(outData, details, 4, 4);
+	NNetBinaryFormat::putValues(outData, outDetails, 8, 2);
+
+	// the layer data
+	for(int i = 0; i <= mNumLayers; i++)		// use <= to include the output layer
+	{
+		const NNetWeightedConnect& connect = mLayers[i];
+		int nIn = connect.getNumInputNodes();
+		int nOut = connect.getNumOutputNodes();
+		int nUnit = (i < mNumLayers) ? (int)mActiveUnits[i] : 0;
+		int layerDetails[6] = { nIn, nOut, nUnit, connect.isSparse() ? 1 : 0, (int)scalars[i], 0 };
+		size_t blockEnd;
+		double layerValues[2] = { 0.0, 0.0 };
+
+		if(i < mNumLayers)
+		{
+			layerValues[0] = mActiveSlope[i];
+			layerValues[1] = mActiveAmplify[i];
+		}
+
+		NNetBinaryFormat::putValues(outData, layerDetails, 4, 6);
+		NNetBinaryFormat::putValues(outData, layerValues, 8, 2);
+
+		blockEnd = outData.size() + NNetBinaryFormat::getWeightBlockSize((size_t)nIn * nOut, scalars[i]);
+
+		if(connect.isSparse())
+		{
+			// pruned connections are written as zeros
+			vector<double> weights;
+
+			for(int j = 0; j < nOut; j++)
+			{
+				connect.getWeightVector(j, weights);
+				writeWeights(outData, weights.data(), nIn, scalars[i]);
+			}
+		}
+		else
+		{
+			writeWeights(outData, connect.getWeightData(), (size_t)nIn * nOut, scalars[i]);
+		}
+
+		// pad 16 bit weights to a multiple of 8 bytes
+		outData.resize(blockEnd, 0);
+
+		// the mask keeps the remaining connections apart from the pruned ones
+		if(connect.isSparse())
+		{
+			vector<bool> mask;
+
+			blockEnd += NNetBinaryFormat::getMaskBlockSize((size_t)nIn * nOut);
+
+			connect.getConnectionMask(mask);
+			writeMask(outData, mask);
+			outData.resize(blockEnd, 0);
+		}
+	}
+
+	// the checksum
+	unsigned long long checksum = NNetBinaryFormat::getChecksum(outData.data(), outData.size());
+
+	NNetBinaryFormat::putValues(outData, &checksum, 8, 1);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// instantiates this network from a binary representation - the data
+/// is checked against its checksum and the network is left empty if
+/// the data is damaged or inconsistent
+/// </summary>
+/// <param name="inData">the binary representation of the network</param>
+/// <param name="length">the length of the binary representation</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NeuralNet::deserializeBinary(const char* inData, size_t length)
+{
+	NNetBinaryFormat format;
+
+	clearNeuralNetwork();
+
+	if(format.readLayout(inData, length) != 0)
+	{
+		return -1;
+	}
+
+	int numHidden = format.getNumLayers();
+
+	// the layer data
+	for(int i = 0; i <= numHidden; i++)		// use <= to include the output layer
+	{
+		int nIn = format.getLayerInputs(i);
+		int nOut = format.getLayerSize(i);
+		size_t pos = format.getWeightOffset(i);
+
+		// the weights are read straight into the layer so it is only sized
+		mLayers.push_back(NNetWeightedConnect());
+
+		NNetWeightedConnect& connect = mLayers.back();
+
+		connect.resize(nIn, nOut);
+
+		readWeights(inData, length, pos, connect.getWeightData(), (size_t)nIn * nOut, format.getLayerScalarType(i));
+
+		// restore the sparse storage of a pruned layer
+		if(format.isLayerPruned(i))
+		{
+			if(format.getMaskOffset(i) != 0)
+			{
+				vector<bool> mask;
+
+				readMask(inData, format.getMaskOffset(i), mask, (size_t)nIn * nOut);
+				connect.pruneByMask(mask);
+			}
+			else
+			{
+				// version 1 and 2 files only mark the pruned connections with zeros
+				connect.pruneByThreshold(0.0);
+			}
+		}
+
+		if(i < numHidden)
+		{
+			mActiveUnits.push_back(format.getLayerType(i));
+			mActiveSlope.push_back(format.getLayerSlope(i));
+			mActiveAmplify.push_back(format.getLayerAmplify(i));
+		}
+	}
+
+	mNumInputs = format.getNumInputs();
+	mNumOutputs = format.getLayerSize(numHidden);
+	mNumLayers = numHidden;
+	mOutUnitType = format.getLayerType(numHidden);
+	mOutUnitSlope = format.getLayerSlope(numHidden);
+	mOutUnitAmplify = format.getLayerAmplify(numHidden);
+
+	packWeights();
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// instantiates this network from a given string representation - 
+/// 
+/// The string is parsed in a single pass with the weights read 
+/// straight into the weighted connections. The numbers of units and 
+/// the activation function types are checked and the network is left
+/// empty if the data is incomplete or inconsistent. Only the layers
+/// marked as pruned are given sparse storage, with an x in the place 
+/// of each pruned connection - any weight, including a zero weight, 
+/// is a remaining connection.
+/// </summary>
+/// <param name="inData">the given string representation of the network</param>
+/// <returns>0 if successful otherwise -1</returns>
+/// 
+int NeuralNet::deserialize(const string& inData)
+{	
+	// the string is terminated so the values can be read with strtol and strtod
+	const char* pos = inData.c_str();
+	const char* end = pos + inData.size();
+	int numInputs, numOutputs, numLayers, outUnitType;
+	double outSlope, outAmplify;
+
+	clearNeuralNetwork();
+
+	// deserialize the main details
+	if(!readInt(pos, numInputs) || !readInt(pos, numOutputs) || !readInt(pos, numLayers) ||
+	   !readInt(pos, outUnitType) || !readDouble(pos, outSlope) || !readDouble(pos, outAmplify) ||
+	   numInputs <= 0 || numOutputs <= 0 || numLayers < 1 || 
+	   outUnitType < kThreshold || outUnitType > kSoftPlus)
+	{
+		return -1;
+	}
+
+	int nPrevOut = numInputs;
+
+	// deserialize the layer data
+	for(int i = 0; i <= numLayers; i++)		// use <= to include the output layer
+	{
+		int nIn, nOut, nUnit;
+		double sUnit, aUnit;
+
+		if(!readTag(pos, 'L') || !readInt(pos, nIn) || !readInt(pos, nOut) || !readInt(pos, nUnit) ||
+		   !readDouble(pos, sUnit) || !readDouble(pos, aUnit))
+		{
+			clearNeuralNetwork();
+			return -1;
+		}
+
+		// each layer must follow on from the previous one and, as every 
+		// weight takes at least two characters, the weights must fit in
+		// the rest of the string before any memory is allocated
+		if(nIn != nPrevOut || nOut <= 0 || (i == numLayers && nOut != numOutputs) ||
+		   (i < numLayers && (nUnit < kThreshold || nUnit > kSoftPlus)) ||
+		   (size_t)nIn * nOut > (size_t)(end - pos + 1) / 2)
+		{
+			clearNeuralNetwork();
+			return -1;
+		}
+
+		// the optional pruned layer marker
+		bool pruned = readTag(pos, 'P');
+
+		// the weights are read straight into the layer so it is only sized
+		mLayers.push_back(NNetWeightedConnect());
+
+		NNetWeightedConnect& connect = mLayers.back();
+
+		connect.resize(nIn, nOut);
+		double* weights = connect.getWeightData();
+		size_t numWeights = (size_t)nIn * nOut;
+		vector<bool> mask;
+
+		if(pruned)
+		{
+			mask.assign(numWeights, true);
+		}
+
+		for(size_t k = 0; k < numWeights; k++)
+		{
+			// the pruned connections of a marked layer are written as an x
+			if(pruned && readTag(pos, 'x'))
+			{
+				weights[k] = 0.0;
+				mask[k] = false;
+			}
+			else if(!readDouble(pos, weights[k]))
+			{
+				clearNeuralNetwork();
+				return -1;
+			}
+		}
+
+		// restore the sparse storage of a marked layer
+		if(pruned)
+		{
+			connect.pruneByMask(mask);
+		}
+
+		if(i < numLayers)
+		{
+			mActiveUnits.push_back((ActiveT)nUnit);
+			mActiveSlope.push_back(sUnit);
+			mActiveAmplify.push_back(aUnit);
+		}
+
+		nPrevOut = nOut;
+	}
+
+	mNumInputs = numInputs;
+	mNumOutputs = numOutputs;
+	mNumLayers = numLayers;
+	mOutUnitType = (ActiveT)outUnitType;
+	mOutUnitSlope = outSlope;
+	mOutUnitAmplify = outAmplify;
+
+	packWeights();
+
+	return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
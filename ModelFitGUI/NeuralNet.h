@@ -1,159 +1,269 @@
-/////////////////////////////////////////////////////////////////////
-//
-// Defines the NeuralNet class
-//
-// Author: Jason Jenkins
-//
-// This class is a representation of a feed forward neural network.
-//
-/////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-/////////////////////////////////////////////////////////////////////
-
-#include <string>
-
-/////////////////////////////////////////////////////////////////////
-
-using namespace std;
-
-/////////////////////////////////////////////////////////////////////
-
-#include "NNetUnit.h"
-#include "NNetWeightedConnect.h"
-
-/////////////////////////////////////////////////////////////////////
-/// <summary>
-/// This class is a representation of a feed forward neural network.
-/// </summary>
-/// 
-class NeuralNet
-{
-public:
-	NeuralNet();
-	virtual ~NeuralNet();
-
-	// constructs a NeuralNet object from a file
-	NeuralNet(const string& fName);
-	
-	// clears a NeuralNet object ready for re-use
-	void clearNeuralNetwork();
-
-	// sets the number of input units
-	void setNumInputs(int numInputs);
-
-	// sets the number of output units
-	void setNumOutputs(int numOutputs);
-
-	// set the output layer units activation function type
-	void setOutputUnitType(ActiveT unitType);
-
-	// set the output layer units activation function slope value
-	void setOutputUnitSlope(double slope);
-
-	// set the output layer units activation function amplify value
-	void setOutputUnitAmplify(double amplify);
-	
-	/// <summary>
-	/// </summary>
-	/// <returns>the number of input units</returns>
-	int getNumInputs() const { return mNumInputs; }
-	
-	/// <summary>	
-	/// </summary>
-	/// <returns>the number of output units</returns>
-	int getNumOutputs() const { return mNumOutputs; }
-	
-	/// <summary>
-	///
-	/// </summary>
-	/// <returns>the number of hidden layers</returns>
-	int getNumLayers() const { return mNumLayers; }
-
-	/// <summary>	
-	/// </summary>
-	/// <returns>the output layer units activation function type</returns>
-	ActiveT getOutputUnitType() const { return mOutUnitType; }
-
-	/// <summary>	
-	/// </summary>
-	/// <returns>the output layer units activation function slope value</returns>
-	double getOutputUnitSlope() const { return mOutUnitSlope; };
-
-	/// <summary>	
-	/// </summary>
-	/// <returns>the output layer units activation function amplify value</returns>
-	double getOutputUnitAmplify() const { return mOutUnitAmplify; };
-
-	// adds a new hidden layer
-	int addLayer(int numUnits, ActiveT unitType = kUnipolar, 
-				 double initRange = 2.0, double slope = 1.0, double amplify = 1.0);
-	
-	// gets the details of the specified hidden layer
-	void getLayerDetails(int n, ActiveT& unitType, double& slope, double& amplify);
-
-	// gets the response of the network to the given input	
-	void getResponse(const vector<double>& inputs, vector<double>& outputs);
-	
-	// gets the activation values for a specified layer
-	void getActivations(vector<double>& activations, int layer);
-
-	// gets the unit input values for a specified layer
-	void getUnitInputs(vector<double>& inputs, int layer);
-
-	// gets the weighted connections for a specified layer
-	void getWeightedConnect(NNetWeightedConnect& wtConnect, int layer);
-
-	// sets the weighted connections for a specified layer
-	void setWeightedConnect(const NNetWeightedConnect& wtConnect, int layer);	
-	
-	// serializes the network and writes it to a file
-	int writeToFile(const string& fname);
-
-private:
-	// generates a string representation of the network
-	string serialize();
-
-	// instantiates a network from a string representation
-	void deserialize(const string& inData);
-	
-private:
-	/// <summary>the number of input units</summary>
-	int mNumInputs;
-
-	/// <summary>the number of output units</summary>
-	int mNumOutputs;
-
-	/// <summary>the number of hidden layers</summary>
-	int mNumLayers;
-	
-	/// <summary>the output layer units activation function type</summary>
-	ActiveT mOutUnitType;
-	
-	/// <summary>the output layer units activation function slope value</summary>
-	double mOutUnitSlope;
-
-	/// <summary>the output layer units activation function amplify value</summary>
-	double mOutUnitAmplify;
-
-	/// <summary>the weighted connections linking the network layers</summary>
-	vector<NNetWeightedConnect> mLayers;
-
-	/// <summary>the activation values for each of the network layers</summary>
-	vector<vector<double> > mActivations;
-
-	/// <summary>the input values for the layer activation functions</summary>
-	vector<vector<double> > mUnitInputs;
-
-	/// <summary>the hidden layer unit activation function types</summary>
-	vector<ActiveT> mActiveUnits;
-	
-	/// <summary>the hidden layer units activation function slope values</summary>
-	vector<double> mActiveSlope;
-	
-	/// <summary>the hidden layer units activation function amplify values</summary>
-	vector<double> mActiveAmplify;
-};
-
-/////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////
+//
+// Defines the NeuralNet class
+//
+// Author: Jason Jenkins
+//
+// This class is a representation of a feed forward neural network.
+//
+/////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <ostream>
+
+/////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+/////////////////////////////////////////////////////////////////////
+
+#include "NNetUnit.h"
+#include "NNetWeightedConnect.h"
+#include "NNetWorkspace.h"
+#include "NNetHalf.h"
+
+/////////////////////////////////////////////////////////////////////
+
+class NNetFrozen;
+
+/////////////////////////////////////////////////////////////////////
+/// <summary>
+/// This class is a representation of a feed forward neural network.
+/// </summary>
+/// 
+class NeuralNet
+{
+public:
+	NeuralNet();
+	virtual ~NeuralNet();
+
+	// constructs a NeuralNet object from a file
+	NeuralNet(const string& fName);
+
+	// copies another network into a new network with its own weight block
+	NeuralNet(const NeuralNet& other);
+
+	// copies another network into this network
+	NeuralNet& operator=(const NeuralNet& other);
+
+	// moves the layers of another network into a new network
+	NeuralNet(NeuralNet&& other) noexcept;
+
+	// moves the layers of another network into this network
+	NeuralNet& operator=(NeuralNet&& other) noexcept;
+	
+	// clears a NeuralNet object ready for re-use
+	void clearNeuralNetwork();
+
+	// sets the number of input units
+	void setNumInputs(int numInputs);
+
+	// sets the number of output units
+	void setNumOutputs(int numOutputs);
+
+	// set the output layer units activation function type
+	void setOutputUnitType(ActiveT unitType);
+
+	// set the output layer units activation function slope value
+	void setOutputUnitSlope(double slope);
+
+	// set the output layer units activation function amplify value
+	void setOutputUnitAmplify(double amplify);
+	
+	/// <summary>
+	/// </summary>
+	/// <returns>the number of input units</returns>
+	int getNumInputs() const { return mNumInputs; }
+	
+	/// <summary>	
+	/// </summary>
+	/// <returns>the number of output units</returns>
+	int getNumOutputs() const { return mNumOutputs; }
+	
+	/// <summary>
+	///
+	/// </summary>
+	/// <returns>the number of hidden layers</returns>
+	int getNumLayers() const { return mNumLayers; }
+
+	/// <summary>	
+	/// </summary>
+	/// <returns>the output layer units activation function type</returns>
+	ActiveT getOutputUnitType() const { return mOutUnitType; }
+
+	/// <summary>	
+	/// </summary>
+	/// <returns>the output layer units activation function slope value</returns>
+	double getOutputUnitSlope() const { return mOutUnitSlope; };
+
+	/// <summary>	
+	/// </summary>
+	/// <returns>the output layer units activation function amplify value</returns>
+	double getOutputUnitAmplify() const { return mOutUnitAmplify; };
+
+	// adds a new hidden layer
+	int addLayer(int numUnits, ActiveT unitType = kUnipolar, 
+				 double initRange = 2.0, double slope = 1.0, double amplify = 1.0);
+	
+	// gets the details of the specified hidden layer
+	void getLayerDetails(int n, ActiveT& unitType, double& slope, double& amplify) const;
+
+	// gets the response of the network to the given input	
+	void getResponse(const vector<double>& inputs, vector<double>& outputs);
+
+	// gets the response of the network using the caller's workspace
+	void getResponse(const vector<double>& inputs, vector<double>& outputs,
+					 NNetWorkspace& workspace) const;
+
+	// gets the responses of the network to a batch of input rows
+	void getResponses(const vector<double>& inputs, vector<double>& outputs, int numThreads = 0) const;
+	void getResponses(const double* inputs, double* outputs, int numRows, int numThreads = 0) const;
+
+	// gets the responses to a batch of input rows evaluating each distinct row only once
+	void getDistinctResponses(const vector<double>& inputs, vector<double>& outputs, int numThreads = 0) const;
+	
+	// produces a compact read only copy of the network for fast responses
+	NNetFrozen freeze() const;
+	NNetFrozen freeze(const vector<ScalarT>& layerScalars) const;
+
+	// gets the activation values for a specified layer
+	void getActivations(vector<double>& activations, int layer) const;
+
+	// gets the unit input values for a specified layer
+	void getUnitInputs(vector<double>& inputs, int layer) const;
+
+	// gets the weighted connections for a specified layer
+	void getWeightedConnect(NNetWeightedConnect& wtConnect, int layer) const;
+
+	/// <summary>
+	/// gets read only access to the activation values for a specified
+	/// layer without copying them (the layer must be valid)
+	/// </summary>
+	/// <returns>the activation values produced by the most recent call to getResponse</returns>
+	const double* getActivations(int layer) const { return mWorkspace.getActivations(layer); }
+
+	/// <summary>
+	/// gets read only access to the unit input values for a specified
+	/// layer without copying them (the layer must be valid)
+	/// </summary>
+	/// <returns>the unit input values produced by the most recent call to getResponse</returns>
+	const double* getUnitInputs(int layer) const { return mWorkspace.getUnitInputs(layer); }
+
+	/// <summary>
+	/// gets read only access to the weighted connections for a specified
+	/// layer without copying them (the layer must be valid)
+	/// </summary>
+	/// <returns>the weighted connections between the layer and the next layer</returns>
+	const NNetWeightedConnect& getWeightedConnect(int layer) const { return mLayers[layer]; }
+
+	/// <summary>
+	/// gets access to the weighted connections for a specified layer so 
+	/// a trainer can update them in place (the layer must be valid)
+	/// </summary>
+	/// <returns>the weighted connections between the layer and the next layer</returns>
+	NNetWeightedConnect& getWeightedConnect(int layer) { return mLayers[layer]; }
+
+	// sets the weighted connections for a specified layer
+	void setWeightedConnect(const NNetWeightedConnect& wtConnect, int layer);	
+
+	// gets the total number of stored weighted connections
+	int getNumWeights() const;
+
+	// checks whether another network has the same topology and activation settings
+	bool hasSameTopology(const NeuralNet& other) const;
+
+	// copies every weighted connection of the network into a single block
+	void getWeights(vector<double>& weights) const;
+
+	// restores every weighted connection of the network from a single block
+	int setWeights(const vector<double>& weights);
+
+	// gathers the weighted connections of every layer into the network's weight block
+	void packWeights();
+	
+	// serializes the network and writes it to a file
+	int writeToFile(const string& fname) const;
+
+	// writes the network to a file in binary form
+	int writeToBinaryFile(const string& fname, ScalarT scalarType = kFloat64) const;
+	int writeToBinaryFile(const string& fname, const vector<ScalarT>& layerScalars) const;
+
+private:
+	// applies the activation function of the specified layer to an array of values
+	void activateLayer(int layer, const double* unitInputs, double* activations, int n) const;
+
+	// checks whether every layer holds its weights in the network's weight block
+	bool hasPackedWeights() const;
+
+	// gets the responses of the network to a contiguous range of input rows
+	void getRangeResponses(const double* inputs, double* outputs, int numRows) const;
+
+	// gets the responses of the network to a small block of input rows
+	void getBlockResponses(const double* inputs, double* outputs, int numRows,
+						   vector<double>& unitInputs, vector<double>& activations) const;
+
+	// writes a string representation of the network to a stream
+	void serialize(ostream& outStream) const;
+
+	// instantiates a network from a string representation
+	int deserialize(const string& inData);
+
+	// generates a binary representation of the network
+	void serializeBinary(vector<char>& outData, const vector<ScalarT>& layerScalars) const;
+
+	// instantiates a network from a binary representation
+	int deserializeBinary(const char* inData, size_t length);
+	
+private:
+	/// <summary>the number of input units</summary>
+	int mNumInputs;
+
+	/// <summary>the number of output units</summary>
+	int mNumOutputs;
+
+	/// <summary>the number of hidden layers</summary>
+	int mNumLayers;
+	
+	/// <summary>the output layer units activation function type</summary>
+	ActiveT mOutUnitType;
+	
+	/// <summary>the output layer units activation function slope value</summary>
+	double mOutUnitSlope;
+
+	/// <summary>the output layer units activation function amplify value</summary>
+	double mOutUnitAmplify;
+
+	/// <summary>the weighted connections linking the network layers</summary>
+	vector<NNetWeightedConnect> mLayers;
+
+	/// <summary>
+	/// the stored weights of every layer held one layer after another in
+	/// a single block of memory - each layer's weighted connections read 
+	/// and update their part of the block in place
+	/// </summary>
+	vector<double> mWeights;
+
+	/// <summary>the start of each layer's weights in the weight block (with a final entry marking the end)</summary>
+	vector<size_t> mWeightOffsets;
+
+	/// <summary>
+	/// the activation and unit input values for each of the network layers 
+	/// produced by the most recent call to getResponse
+	/// </summary>
+	NNetWorkspace mWorkspace;
+
+	/// <summary>the hidden layer unit activation function types</summary>
+	vector<ActiveT> mActiveUnits;
+	
+	/// <summary>the hidden layer units activation function slope values</summary>
+	vector<double> mActiveSlope;
+	
+	/// <summary>the hidden layer units activation function amplify values</summary>
+	vector<double> mActiveAmplify;
+};
+
+/////////////////////////////////////////////////////////////////////